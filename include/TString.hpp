@@ -1,15 +1,31 @@
 #ifndef TSTRING_HPP
 #define TSTRING_HPP
 
+#include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <format>
+#include <memory>
+#include <new>
 #include <ostream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#if defined(_WIN32) || defined(__linux__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+#ifdef TSTRING_INSTRUMENT
+#include "TStringInstrument.hpp"
+#endif
+
 #ifdef TCSTRING_SUPPORT
 extern "C"
 {
@@ -17,162 +33,430 @@ extern "C"
 }
 #endif
 
-#ifndef min
-#define min(a, b) ((a) < (b) ? (a) : (b))
+// Growth policies decide how many bytes TStringBasic allocates. initial() sizes
+// a fresh buffer that has to hold required bytes, including the terminator;
+// grow() sizes the replacement when a string outgrows a buffer of the given
+// capacity. With claimsSlack the allocator's usable size of the block becomes
+// the capacity, so the bytes it rounds up to are not wasted.
+
+// Every buffer is a power of two. Growth is cheap to compute, but a 513-byte
+// string occupies 1024 bytes.
+struct TStringGrowthPowerOfTwo
+{
+    static constexpr bool claimsSlack = false;
+
+    static constexpr size_t initial(size_t required)
+    {
+        if (required <= 1)
+            return 1;
+        required--;
+        required |= required >> 1;
+        required |= required >> 2;
+        required |= required >> 4;
+        required |= required >> 8;
+        required |= required >> 16;
+#if SIZE_MAX > 0xFFFFFFFF
+        required |= required >> 32;
+#endif
+        required++;
+        return required;
+    }
+
+    static constexpr size_t grow(size_t, size_t required)
+    {
+        return initial(required);
+    }
+};
+
+// Fresh buffers fit their contents, and a full buffer grows by half.
+struct TStringGrowthGeometric
+{
+    static constexpr bool claimsSlack = false;
+
+    static constexpr size_t initial(size_t required)
+    {
+        return required > 1 ? required : 1;
+    }
+
+    static constexpr size_t grow(size_t capacity, size_t required)
+    {
+        size_t grown = capacity + capacity / 2;
+        return grown > required ? grown : required;
+    }
+};
+
+// Like TStringGrowthGeometric, and every buffer also takes the slack up to
+// the allocator's size class.
+struct TStringGrowthExactFit
+{
+    static constexpr bool claimsSlack = true;
+
+    static constexpr size_t initial(size_t required)
+    {
+        return TStringGrowthGeometric::initial(required);
+    }
+
+    static constexpr size_t grow(size_t capacity, size_t required)
+    {
+        return TStringGrowthGeometric::grow(capacity, required);
+    }
+};
+
+// Usable size of a block from std::malloc that was requested with the given size
+inline size_t tstring_usable_size(void *ptr, size_t requested)
+{
+#if defined(_WIN32)
+    (void)requested;
+    return _msize(ptr);
+#elif defined(__APPLE__)
+    (void)requested;
+    return malloc_size(ptr);
+#elif defined(__linux__)
+    (void)requested;
+    return malloc_usable_size(ptr);
+#else
+    (void)ptr;
+    return requested;
+#endif
+}
+
+// Policy of TString, the string type every other header uses
+#ifndef TSTRING_GROWTH_POLICY
+#define TSTRING_GROWTH_POLICY TStringGrowthPowerOfTwo
 #endif
 
-class TString
+// The fixed prefix of every TStringBasic, which C code such as TCString reads through tc_str() and
+// c_layout(). The buffer is NUL-terminated at length and was allocated with std::malloc.
+struct TStringLayout
+{
+    size_t length;
+    char *buffer;
+};
+
+// Everything except find and the TCString hashes is constexpr. A TString built in a constant expression
+// takes its buffer from std::allocator and has to be destroyed before the expression ends; tstring_freeze
+// keeps the result.
+template <typename Growth> class TStringBasic
 {
   private:
+    // length and buffer come first and in this order, so a TString can be read as a TStringLayout
     size_t length;
     char *buffer;
+    size_t capacity;
 
-    constexpr size_t getClosestPowerOfTwo(size_t size) const
+    // Allocates at least capacity bytes and raises capacity to what the policy may use. Constant
+    // evaluation cannot call malloc, so there the block comes from std::allocator and is exactly capacity.
+    static constexpr char *allocateBuffer(size_t &capacity)
     {
-        if (size <= 1)
-            return 1;
-        size--;
-        size |= size >> 1;
-        size |= size >> 2;
-        size |= size >> 4;
-        size |= size >> 8;
-        size |= size >> 16;
-#if SIZE_MAX > 0xFFFFFFFF
-        size |= size >> 32;
+        if (std::is_constant_evaluated())
+        {
+            return std::allocator<char>().allocate(capacity);
+        }
+#ifdef TSTRING_INSTRUMENT
+        TStringInstrument::on_allocate(capacity);
+#endif
+        char *ptr = static_cast<char *>(std::malloc(capacity));
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        if constexpr (Growth::claimsSlack)
+        {
+            capacity = tstring_usable_size(ptr, capacity);
+        }
+        return ptr;
+    }
+
+    // Frees a block from allocateBuffer; std::allocator needs the capacity it was given back
+    static constexpr void releaseBuffer(char *ptr, size_t capacity)
+    {
+        if (std::is_constant_evaluated())
+        {
+            if (ptr != nullptr)
+            {
+                std::allocator<char>().deallocate(ptr, capacity);
+            }
+            return;
+        }
+#ifdef TSTRING_INSTRUMENT
+        if (ptr != nullptr)
+        {
+            TStringInstrument::on_free();
+        }
+#endif
+        std::free(ptr);
+    }
+
+    // src is null only for a moved-from string, which has nothing to copy
+    static constexpr void copyBytes(char *dest, const char *src, size_t count)
+    {
+        if (src == nullptr)
+        {
+            return;
+        }
+        if (std::is_constant_evaluated())
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                dest[i] = src[i];
+            }
+            return;
+        }
+#ifdef TSTRING_INSTRUMENT
+        TStringInstrument::on_copy(count);
+#endif
+        std::memcpy(dest, src, count);
+    }
+
+    // Like copyBytes, for a source that may overlap dest but never starts before it
+    static constexpr void moveBytes(char *dest, const char *src, size_t count)
+    {
+        if (src == nullptr)
+        {
+            return;
+        }
+        if (std::is_constant_evaluated())
+        {
+            copyBytes(dest, src, count);
+            return;
+        }
+#ifdef TSTRING_INSTRUMENT
+        TStringInstrument::on_copy(count);
+#endif
+        std::memmove(dest, src, count);
+    }
+
+    // Byte-lexicographic order as unsigned bytes, then the shorter string first, like TStringConst. Embedded
+    // NULs are compared like any other byte.
+    constexpr int compareTo(const char *str, size_t len) const
+    {
+        return std::string_view(buffer, length).compare(std::string_view(str, len));
+    }
+
+    static constexpr void noteGrowth()
+    {
+#ifdef TSTRING_INSTRUMENT
+        if (!std::is_constant_evaluated())
+        {
+            TStringInstrument::on_grow();
+        }
 #endif
-        size++;
-        return size;
+    }
+
+    // Gives the string a fresh buffer for required bytes, sized by the policy
+    constexpr void allocate(size_t required)
+    {
+        capacity = Growth::initial(required);
+        buffer = allocateBuffer(capacity);
+    }
+
+    struct UninitializedTag
+    {
+    };
+
+    struct AdoptTag
+    {
+    };
+
+    constexpr TStringBasic(AdoptTag, char *ptr, size_t len, size_t bufferCapacity)
+        : length(len), buffer(ptr), capacity(bufferCapacity)
+    {
+    }
+
+    // Allocates room for len characters and terminates the buffer; the caller writes the contents
+    constexpr TStringBasic(UninitializedTag, size_t len) : length(len)
+    {
+        allocate(length + 1);
+        buffer[length] = '\0';
+    }
+
+    // This string followed by len bytes from str, in a single allocation
+    constexpr TStringBasic concat(const char *str, size_t len) const
+    {
+        TStringBasic result(UninitializedTag{}, length + len);
+        copyBytes(result.buffer, buffer, length);
+        copyBytes(result.buffer + length, str, len);
+        return result;
+    }
+
+    // Moves the string into a new buffer of the given capacity and terminates it; a moved-from string has no
+    // buffer and no terminator to copy
+    constexpr void reallocate(size_t newCapacity)
+    {
+        char *newBuffer = allocateBuffer(newCapacity);
+        copyBytes(newBuffer, buffer, length);
+        newBuffer[length] = '\0';
+        releaseBuffer(buffer, capacity);
+        buffer = newBuffer;
+        capacity = newCapacity;
+    }
+
+    // Like reallocate, counted as a growth in instrumented builds
+    constexpr void growBuffer(size_t newCapacity)
+    {
+        noteGrowth();
+        reallocate(newCapacity);
+    }
+
+    // Makes room for required bytes, including the terminator
+    constexpr void ensureCapacity(size_t required)
+    {
+        if (required > capacity)
+        {
+            growBuffer(Growth::grow(capacity, required));
+        }
+    }
+
+    // Replaces the contents, reusing the buffer when they fit; str may point into the buffer
+    constexpr void assign(const char *str, size_t len)
+    {
+        if (buffer == nullptr || len + 1 > capacity)
+        {
+            size_t newCapacity = Growth::initial(len + 1);
+            char *newBuffer = allocateBuffer(newCapacity);
+            copyBytes(newBuffer, str, len);
+            releaseBuffer(buffer, capacity);
+            buffer = newBuffer;
+            capacity = newCapacity;
+        }
+        else
+        {
+            moveBytes(buffer, str, len);
+        }
+        length = len;
+        buffer[length] = '\0';
     }
 
   public:
-    inline TString() : length(0), buffer(new char[1])
+    constexpr TStringBasic() : length(0)
     {
+        allocate(1);
         buffer[0] = '\0';
     }
 
-    inline TString(const char *str) : length(strlen(str))
+    constexpr TStringBasic(const char *str) : length(std::char_traits<char>::length(str))
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, str, length + 1);
+        allocate(length + 1);
+        copyBytes(buffer, str, length + 1);
     }
 
-    inline TString(const char *str, size_t len) : length(len)
+    constexpr TStringBasic(const char *str, size_t len) : length(len)
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, str, length);
+        allocate(length + 1);
+        copyBytes(buffer, str, length);
         buffer[length] = '\0';
     }
 
-    inline TString(const TString &str, size_t len) : length(len)
+    constexpr TStringBasic(const TStringBasic &str, size_t len) : length(len)
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, str.buffer, length);
+        allocate(length + 1);
+        copyBytes(buffer, str.buffer, length);
         buffer[length] = '\0';
     }
 
-    inline TString(char ch) : length(1)
+    constexpr TStringBasic(char ch) : length(1)
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
+        allocate(length + 1);
         buffer[0] = ch;
         buffer[1] = '\0';
     }
 
-    inline TString(const std::string &str) : length(str.size())
+    constexpr TStringBasic(const std::string &str) : length(str.size())
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, str.c_str(), length + 1);
+        allocate(length + 1);
+        copyBytes(buffer, str.c_str(), length + 1);
     }
 
-    inline TString(size_t capacity) : length(0)
+    constexpr TStringBasic(std::string_view str) : length(str.size())
     {
-        size_t adjustedCapacity = getClosestPowerOfTwo(capacity);
-        buffer = new char[adjustedCapacity];
+        allocate(length + 1);
+        copyBytes(buffer, str.data(), length);
+        buffer[length] = '\0';
+    }
+
+    // An empty string with room for reserved bytes, including the terminator
+    constexpr TStringBasic(size_t reserved) : length(0)
+    {
+        allocate(reserved);
         buffer[0] = '\0';
     }
 
-    inline TString(const TString &other) : length(other.length)
+    constexpr TStringBasic(const TStringBasic &other) : length(other.length)
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, other.buffer, length + 1);
+        allocate(length + 1);
+        copyBytes(buffer, other.buffer, length);
+        buffer[length] = '\0';
     }
 
-    inline TString(TString &&other) noexcept : length(other.length), buffer(other.buffer)
+    constexpr TStringBasic(TStringBasic &&other) noexcept
+        : length(other.length), buffer(other.buffer), capacity(other.capacity)
     {
         other.buffer = nullptr;
         other.length = 0;
+        other.capacity = 0;
     }
 
-    inline TString &operator=(const TString &other)
+    constexpr TStringBasic &operator=(const TStringBasic &other)
     {
         if (this != &other)
         {
-            delete[] buffer;
-            length = other.length;
-            size_t capacity = getClosestPowerOfTwo(length + 1);
-            buffer = new char[capacity];
-            std::memcpy(buffer, other.buffer, length + 1);
+            assign(other.buffer, other.length);
         }
         return *this;
     }
 
-    inline TString &operator=(TString &&other) noexcept
+    constexpr TStringBasic &operator=(TStringBasic &&other) noexcept
     {
         if (this != &other)
         {
-            delete[] buffer;
+            releaseBuffer(buffer, capacity);
             length = other.length;
             buffer = other.buffer;
+            capacity = other.capacity;
             other.buffer = nullptr;
             other.length = 0;
+            other.capacity = 0;
         }
         return *this;
     }
 
-    inline TString &operator=(const std::string &str)
+    constexpr TStringBasic &operator=(const std::string &str)
     {
-        delete[] buffer;
-        length = str.size();
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, str.c_str(), length + 1);
+        assign(str.data(), str.size());
         return *this;
     }
 
-    inline TString &operator=(const char *str)
+    constexpr TStringBasic &operator=(const char *str)
     {
-        delete[] buffer;
-        length = strlen(str);
-        size_t capacity = getClosestPowerOfTwo(length + 1);
-        buffer = new char[capacity];
-        std::memcpy(buffer, str, length + 1);
+        assign(str, std::char_traits<char>::length(str));
         return *this;
     }
 
-    inline ~TString()
+    constexpr ~TStringBasic()
     {
-        delete[] buffer;
+        releaseBuffer(buffer, capacity);
     }
 
-    inline void reserve(size_t newCapacity)
+    // Makes room for at least newCapacity bytes, including the terminator
+    constexpr void reserve(size_t newCapacity)
     {
-        size_t capacity = getClosestPowerOfTwo(length + 1);
         if (newCapacity > capacity)
         {
-            size_t reservedCapacity = getClosestPowerOfTwo(newCapacity);
-            char *newBuffer = new char[reservedCapacity];
-            std::memcpy(newBuffer, buffer, length + 1);
-            delete[] buffer;
-            buffer = newBuffer;
+            growBuffer(Growth::initial(newCapacity));
+        }
+    }
+
+    // Reallocates the buffer at the size the policy gives a fresh copy, if that is smaller. A shrink is not
+    // counted as a growth.
+    constexpr void shrink_to_fit()
+    {
+        if (Growth::initial(length + 1) < capacity)
+        {
+            reallocate(Growth::initial(length + 1));
         }
     }
 
-    inline size_t size() const
+    constexpr size_t size() const
     {
         return length;
     }
@@ -186,260 +470,432 @@ class TString
     {
         return buffer;
     }
+
+    constexpr operator std::string_view() const
+    {
+        return std::string_view(buffer, length);
+    }
+
+    // The string as C code sees it; the layout is checked here, where the class is complete
+    inline const TStringLayout *c_layout() const
+    {
+        static_assert(std::is_standard_layout_v<TStringBasic>, "TStringBasic must stay standard-layout");
+        static_assert(offsetof(TStringBasic, length) == offsetof(TStringLayout, length) &&
+                          offsetof(TStringBasic, buffer) == offsetof(TStringLayout, buffer),
+                      "TStringBasic must start with the fields of TStringLayout");
+        return reinterpret_cast<const TStringLayout *>(this);
+    }
 #ifdef TCSTRING_SUPPORT
-    constexpr const TCString *tc_str() const
+    inline const TCString *tc_str() const
     {
-        return (TCString *)this;
+        static_assert(sizeof(TCString) <= sizeof(TStringBasic) && alignof(TCString) <= alignof(TStringBasic),
+                      "TCString must fit in the prefix of TStringBasic");
+        return reinterpret_cast<const TCString *>(c_layout());
     }
 
-    constexpr operator const TCString *() const
+    inline operator const TCString *() const
     {
-        return (TCString *)this;
+        return tc_str();
     }
 #endif
-    inline size_t buffer_size() const
+
+    // Takes ownership of ptr, a std::malloc block of capacity bytes holding len bytes of contents. The
+    // terminator is written at len. Throws std::invalid_argument when there is no room for it. Instrumented
+    // builds count the block as an allocation, since the string frees it.
+    static inline TStringBasic adopt(char *ptr, size_t len, size_t capacity)
     {
-        return getClosestPowerOfTwo(length + 1);
+        if (ptr == nullptr || len >= capacity)
+        {
+            throw std::invalid_argument("Adopted buffer has no room for the terminator");
+        }
+#ifdef TSTRING_INSTRUMENT
+        TStringInstrument::on_allocate(capacity);
+#endif
+        TStringBasic result(AdoptTag{}, ptr, len, capacity);
+        result.buffer[len] = '\0';
+        return result;
     }
 
-    inline void append(const TString &str)
+    // Hands the buffer, a NUL-terminated std::malloc block, to the caller, who frees it with std::free.
+    // The string is left empty like a moved-from one, and can be appended to or assigned again. Instrumented
+    // builds count the handed-over block as freed.
+    inline char *release()
     {
-        size_t newLength = length + str.length;
-        size_t newCapacity = getClosestPowerOfTwo(newLength + 1);
-        if (newCapacity > getClosestPowerOfTwo(length + 1))
+#ifdef TSTRING_INSTRUMENT
+        if (buffer != nullptr)
         {
-            char *newBuffer = new char[newCapacity];
-            std::memcpy(newBuffer, buffer, length);
-            delete[] buffer;
-            buffer = newBuffer;
+            TStringInstrument::on_free();
         }
-        std::memcpy(buffer + length, str.buffer, str.length + 1);
-        length = newLength;
+#endif
+        char *ptr = buffer;
+        buffer = nullptr;
+        length = 0;
+        capacity = 0;
+        return ptr;
+    }
+    // Bytes the string can hold, including the terminator, before it has to grow
+    constexpr size_t buffer_size() const
+    {
+        return capacity;
     }
 
-    inline void append(const char *str)
+    constexpr void append(const char *str, size_t len)
     {
-        size_t strLength = strlen(str);
-        size_t newLength = length + strLength;
-        size_t newCapacity = getClosestPowerOfTwo(newLength + 1);
-        if (newCapacity > getClosestPowerOfTwo(length + 1))
+        size_t newLength = length + len;
+        if (newLength + 1 > capacity)
         {
-            char *newBuffer = new char[newCapacity];
-            std::memcpy(newBuffer, buffer, length);
-            delete[] buffer;
+            // str may point into the current buffer, so it is copied before the old buffer is released
+            noteGrowth();
+            size_t newCapacity = Growth::grow(capacity, newLength + 1);
+            char *newBuffer = allocateBuffer(newCapacity);
+            copyBytes(newBuffer, buffer, length);
+            copyBytes(newBuffer + length, str, len);
+            releaseBuffer(buffer, capacity);
             buffer = newBuffer;
+            capacity = newCapacity;
+        }
+        else
+        {
+            copyBytes(buffer + length, str, len);
         }
-        std::memcpy(buffer + length, str, strLength + 1);
         length = newLength;
+        buffer[length] = '\0';
+    }
+
+    constexpr void append(const TStringBasic &str)
+    {
+        append(str.buffer, str.length);
+    }
+
+    constexpr void append(const char *str)
+    {
+        append(str, std::char_traits<char>::length(str));
+    }
+
+    constexpr void append(const std::string &str)
+    {
+        append(str.data(), str.size());
+    }
+
+    constexpr void append(std::string_view str)
+    {
+        append(str.data(), str.size());
     }
 
-    inline void append(const std::string &str)
+    constexpr void append(size_t count, char ch)
     {
-        size_t strLength = str.size();
-        size_t newLength = length + strLength;
-        size_t newCapacity = getClosestPowerOfTwo(newLength + 1);
-        if (newCapacity > getClosestPowerOfTwo(length + 1))
+        size_t newLength = length + count;
+        ensureCapacity(newLength + 1);
+        if (std::is_constant_evaluated())
         {
-            char *newBuffer = new char[newCapacity];
-            std::memcpy(newBuffer, buffer, length);
-            delete[] buffer;
-            buffer = newBuffer;
+            for (size_t i = 0; i < count; ++i)
+            {
+                buffer[length + i] = ch;
+            }
+        }
+        else
+        {
+            std::memset(buffer + length, ch, count);
         }
-        std::memcpy(buffer + length, str.c_str(), strLength + 1);
         length = newLength;
+        buffer[length] = '\0';
+    }
+
+    constexpr void push_back(char ch)
+    {
+        ensureCapacity(length + 2);
+        buffer[length++] = ch;
+        buffer[length] = '\0';
+    }
+
+    constexpr void resize(size_t newLength, char ch = '\0')
+    {
+        if (newLength > length)
+        {
+            append(newLength - length, ch);
+        }
+        else if (buffer == nullptr)
+        {
+            clear();
+        }
+        else
+        {
+            length = newLength;
+            buffer[length] = '\0';
+        }
+    }
+
+    // Grows the buffer to hold count characters without initializing them, then
+    // calls op(data, count), which writes the contents and returns the new length
+    // (at most count). The first size() characters are kept.
+    template <typename Operation> constexpr void resize_and_overwrite(size_t count, Operation op)
+    {
+        ensureCapacity(count + 1);
+        length = static_cast<size_t>(op(buffer, count));
+        buffer[length] = '\0';
     }
 
-    inline void clear()
+    // Empties the string and keeps its buffer
+    constexpr void clear()
     {
+        if (buffer == nullptr)
+        {
+            allocate(1);
+        }
         length = 0;
-        delete[] buffer;
-        buffer = new char[1];
         buffer[0] = '\0';
     }
 
-    inline bool empty() const
+    constexpr bool empty() const
     {
         return length == 0;
     }
 
-    inline char *begin()
+    constexpr char *begin()
     {
         return buffer;
     }
 
-    inline char *end()
+    constexpr char *end()
     {
         return buffer + length;
     }
 
-    inline char &operator[](size_t index)
+    constexpr char &operator[](size_t index)
     {
         return buffer[index];
     }
 
-    inline const char &operator[](size_t index) const
+    constexpr const char &operator[](size_t index) const
     {
         return buffer[index];
     }
 
-    inline bool operator==(const TString &other) const
+    constexpr bool operator==(const TStringBasic &other) const
     {
-        return std::strcmp(buffer, other.buffer) == 0;
+        return length == other.length && compareTo(other.buffer, other.length) == 0;
     }
 
-    inline bool operator==(const char *str) const
+    constexpr bool operator==(const char *str) const
     {
-        return std::strcmp(buffer, str) == 0;
+        size_t len = std::char_traits<char>::length(str);
+        return length == len && compareTo(str, len) == 0;
     }
 
-    inline bool operator==(const std::string &str) const
+    constexpr bool operator==(const std::string &str) const
     {
-        return std::strcmp(buffer, str.c_str()) == 0;
+        return length == str.size() && compareTo(str.data(), str.size()) == 0;
     }
 
-    inline bool operator!=(const TString &other) const
+    constexpr bool operator==(std::string_view str) const
+    {
+        return length == str.size() && compareTo(str.data(), str.size()) == 0;
+    }
+
+    constexpr bool operator!=(const TStringBasic &other) const
     {
         return !(*this == other);
     }
 
-    inline bool operator!=(const char *str) const
+    constexpr bool operator!=(const char *str) const
     {
         return !(*this == str);
     }
 
-    inline bool operator!=(const std::string &str) const
+    constexpr bool operator!=(const std::string &str) const
     {
         return !(*this == str);
     }
 
-    inline bool operator<(const TString &other) const
+    constexpr bool operator!=(std::string_view str) const
     {
-        return std::strcmp(buffer, other.buffer) < 0;
+        return !(*this == str);
     }
 
-    inline bool operator<(const char *str) const
+    constexpr bool operator<(const TStringBasic &other) const
     {
-        return std::strcmp(buffer, str) < 0;
+        return compareTo(other.buffer, other.length) < 0;
     }
 
-    inline bool operator<(const std::string &str) const
+    constexpr bool operator<(const char *str) const
     {
-        return std::strcmp(buffer, str.c_str()) < 0;
+        return compareTo(str, std::char_traits<char>::length(str)) < 0;
     }
 
-    inline bool operator<=(const TString &other) const
+    constexpr bool operator<(const std::string &str) const
     {
-        return std::strcmp(buffer, other.buffer) <= 0;
+        return compareTo(str.data(), str.size()) < 0;
     }
 
-    inline bool operator<=(const char *str) const
+    constexpr bool operator<=(const TStringBasic &other) const
     {
-        return std::strcmp(buffer, str) <= 0;
+        return compareTo(other.buffer, other.length) <= 0;
     }
 
-    inline bool operator<=(const std::string &str) const
+    constexpr bool operator<=(const char *str) const
     {
-        return std::strcmp(buffer, str.c_str()) <= 0;
+        return compareTo(str, std::char_traits<char>::length(str)) <= 0;
     }
 
-    inline bool operator>(const TString &other) const
+    constexpr bool operator<=(const std::string &str) const
     {
-        return std::strcmp(buffer, other.buffer) > 0;
+        return compareTo(str.data(), str.size()) <= 0;
     }
 
-    inline bool operator>(const char *str) const
+    constexpr bool operator>(const TStringBasic &other) const
     {
-        return std::strcmp(buffer, str) > 0;
+        return compareTo(other.buffer, other.length) > 0;
     }
 
-    inline bool operator>(const std::string &str) const
+    constexpr bool operator>(const char *str) const
     {
-        return std::strcmp(buffer, str.c_str()) > 0;
+        return compareTo(str, std::char_traits<char>::length(str)) > 0;
     }
 
-    inline bool operator>=(const TString &other) const
+    constexpr bool operator>(const std::string &str) const
     {
-        return std::strcmp(buffer, other.buffer) >= 0;
+        return compareTo(str.data(), str.size()) > 0;
     }
 
-    inline bool operator>=(const char *str) const
+    constexpr bool operator>=(const TStringBasic &other) const
     {
-        return std::strcmp(buffer, str) >= 0;
+        return compareTo(other.buffer, other.length) >= 0;
     }
 
-    inline bool operator>=(const std::string &str) const
+    constexpr bool operator>=(const char *str) const
     {
-        return std::strcmp(buffer, str.c_str()) >= 0;
+        return compareTo(str, std::char_traits<char>::length(str)) >= 0;
     }
 
-    inline TString &operator+=(const TString &str)
+    constexpr bool operator>=(const std::string &str) const
+    {
+        return compareTo(str.data(), str.size()) >= 0;
+    }
+
+    constexpr TStringBasic &operator+=(const TStringBasic &str) &
     {
         append(str);
         return *this;
     }
 
-    inline TString &operator+=(const char *str)
+    constexpr TStringBasic &operator+=(const char *str) &
     {
         append(str);
         return *this;
     }
 
-    inline TString &operator+=(const std::string &str)
+    constexpr TStringBasic &operator+=(const std::string &str) &
     {
         append(str);
         return *this;
     }
 
-    inline TString operator+(const TString &other) const
+    constexpr TStringBasic &operator+=(std::string_view str) &
     {
-        TString result(*this);
-        result.append(other);
-        return result;
+        append(str);
+        return *this;
     }
 
-    inline TString operator+(const char *str) const
+    constexpr TStringBasic &operator+=(char ch) &
     {
-        TString result(*this);
-        result.append(str);
-        return result;
+        push_back(ch);
+        return *this;
     }
 
-    inline TString operator+(const std::string &str) const
+    // On a temporary, += appends in place and hands the buffer on
+    constexpr TStringBasic operator+=(const TStringBasic &str) &&
     {
-        TString result(*this);
-        result.append(str);
-        return result;
+        append(str);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+=(const char *str) &&
+    {
+        append(str);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+=(const std::string &str) &&
+    {
+        append(str);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+=(std::string_view str) &&
+    {
+        append(str);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+=(char ch) &&
+    {
+        push_back(ch);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+(const TStringBasic &other) const &
+    {
+        return concat(other.buffer, other.length);
     }
 
-    inline TString substr(size_t pos, size_t len) const
+    constexpr TStringBasic operator+(const char *str) const &
+    {
+        return concat(str, std::char_traits<char>::length(str));
+    }
+
+    constexpr TStringBasic operator+(const std::string &str) const &
+    {
+        return concat(str.data(), str.size());
+    }
+
+    // a + b + c reuses the buffer of a + b instead of copying it again
+    constexpr TStringBasic operator+(const TStringBasic &other) &&
+    {
+        append(other);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+(const char *str) &&
+    {
+        append(str);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic operator+(const std::string &str) &&
+    {
+        append(str);
+        return std::move(*this);
+    }
+
+    constexpr TStringBasic substr(size_t pos, size_t len) const
     {
         if (pos > length)
         {
             throw std::out_of_range("Position out of range");
         }
-        size_t actualLen = min(len, length - pos);
-        TString result(actualLen + 1);
-        std::memcpy(result.buffer, buffer + pos, actualLen);
+        size_t actualLen = (len < length - pos) ? len : (length - pos);
+        TStringBasic result(actualLen + 1);
+        copyBytes(result.buffer, buffer + pos, actualLen);
         result.buffer[actualLen] = '\0';
         result.length = actualLen;
         return result;
     }
 
-    inline TString substr(size_t pos) const
+    constexpr TStringBasic substr(size_t pos) const
     {
         if (pos > length)
         {
             throw std::out_of_range("Position out of range");
         }
         size_t actualLen = length - pos;
-        TString result(actualLen + 1);
-        std::memcpy(result.buffer, buffer + pos, actualLen);
+        TStringBasic result(actualLen + 1);
+        copyBytes(result.buffer, buffer + pos, actualLen);
         result.buffer[actualLen] = '\0';
         result.length = actualLen;
         return result;
     }
 
-    inline size_t find(const TString &str) const
+    inline size_t find(const TStringBasic &str) const
     {
         if (str.length == 0)
             return 0;
@@ -475,9 +931,9 @@ class TString
         return find(str.c_str());
     }
 
-    inline std::vector<TString> split(const char delimiter) const
+    constexpr std::vector<TStringBasic> split(const char delimiter) const
     {
-        std::vector<TString> result;
+        std::vector<TStringBasic> result;
         size_t start = 0;
         for (size_t i = 0; i < length; ++i)
         {
@@ -510,25 +966,27 @@ class TString
 #endif
 };
 
+using TString = TStringBasic<TSTRING_GROWTH_POLICY>;
+
 #ifdef STL_SUPPORT
 namespace std
 {
-inline ostream &operator<<(ostream &stream, const TString &str)
+template <typename Growth> inline ostream &operator<<(ostream &stream, const TStringBasic<Growth> &str)
 {
     return stream << string_view(str.c_str(), str.size());
 }
 
-template <> struct hash<TString>
+template <typename Growth> struct hash<TStringBasic<Growth>>
 {
-    inline size_t operator()(const TString &str) const
+    inline size_t operator()(const TStringBasic<Growth> &str) const
     {
-        return std::hash<std::string>()(str.c_str());
+        return std::hash<string_view>()(string_view(str.c_str(), str.size()));
     }
 };
 
-template <> struct formatter<TString> : formatter<string_view>
+template <typename Growth> struct formatter<TStringBasic<Growth>> : formatter<string_view>
 {
-    template <typename FormatContext> auto format(const TString &str, FormatContext &ctx) const
+    template <typename FormatContext> auto format(const TStringBasic<Growth> &str, FormatContext &ctx) const
     {
         return formatter<string_view>::format(string_view(str.c_str(), str.size()), ctx);
     }
@@ -536,18 +994,24 @@ template <> struct formatter<TString> : formatter<string_view>
 }
 #endif
 
-inline TString operator"" _T(const char *str, size_t)
+constexpr TString operator"" _T(const char *str, size_t)
 {
     return TString(str);
 }
 
 class TStringConst
 {
+  public:
+    static constexpr size_t npos = std::string::npos;
+
   private:
+    // Needles shorter than this are searched with memchr and memcmp at runtime.
+    static constexpr size_t shortNeedle = 32;
+
     const char *buffer;
     size_t length;
 
-    constexpr size_t const_strlen(const char *str) const
+    static constexpr size_t const_strlen(const char *str)
     {
         size_t len = 0;
         while (str[len] != '\0')
@@ -557,25 +1021,201 @@ class TStringConst
         return len;
     }
 
-    constexpr int const_strcmp(const char *str1, const char *str2) const
+    // Compares as unsigned bytes up to the shorter length, then by length.
+    static constexpr int const_compare(const char *str1, size_t len1, const char *str2, size_t len2)
     {
-        size_t i = 0;
-        while (str1[i] != '\0' && str2[i] != '\0')
+        size_t common = len1 < len2 ? len1 : len2;
+        if (std::is_constant_evaluated())
+        {
+            for (size_t i = 0; i < common; ++i)
+            {
+                unsigned char a = static_cast<unsigned char>(str1[i]);
+                unsigned char b = static_cast<unsigned char>(str2[i]);
+                if (a != b)
+                {
+                    return a < b ? -1 : 1;
+                }
+            }
+        }
+        else if (common != 0)
         {
-            if (str1[i] != str2[i])
+            int result = std::memcmp(str1, str2, common);
+            if (result != 0)
             {
-                return (str1[i] < str2[i]) ? -1 : 1;
+                return result < 0 ? -1 : 1;
             }
-            ++i;
         }
-        if (str1[i] == '\0' && str2[i] == '\0')
+        if (len1 == len2)
         {
             return 0;
         }
-        return (str1[i] == '\0') ? -1 : 1;
+        return len1 < len2 ? -1 : 1;
+    }
+
+    // Crochemore-Perrin critical factorization of a needle read through at(i).
+    // Returns the start of the right half and stores the period of the needle.
+    template <typename Needle>
+    static constexpr size_t const_critical_factorization(Needle at, size_t m, size_t &period)
+    {
+        size_t maxSuffix = SIZE_MAX;
+        size_t j = 0;
+        size_t k = 1;
+        size_t p = 1;
+        while (j + k < m)
+        {
+            unsigned char a = at(j + k);
+            unsigned char b = at(maxSuffix + k);
+            if (a < b)
+            {
+                j += k;
+                k = 1;
+                p = j - maxSuffix;
+            }
+            else if (a == b)
+            {
+                if (k != p)
+                {
+                    ++k;
+                }
+                else
+                {
+                    j += p;
+                    k = 1;
+                }
+            }
+            else
+            {
+                maxSuffix = j++;
+                k = p = 1;
+            }
+        }
+        period = p;
+
+        size_t maxSuffixRev = SIZE_MAX;
+        j = 0;
+        k = p = 1;
+        while (j + k < m)
+        {
+            unsigned char a = at(j + k);
+            unsigned char b = at(maxSuffixRev + k);
+            if (b < a)
+            {
+                j += k;
+                k = 1;
+                p = j - maxSuffixRev;
+            }
+            else if (a == b)
+            {
+                if (k != p)
+                {
+                    ++k;
+                }
+                else
+                {
+                    j += p;
+                    k = 1;
+                }
+            }
+            else
+            {
+                maxSuffixRev = j++;
+                k = p = 1;
+            }
+        }
+        if (maxSuffixRev + 1 < maxSuffix + 1)
+        {
+            return maxSuffix + 1;
+        }
+        period = p;
+        return maxSuffixRev + 1;
+    }
+
+    // Two-Way string matching: O(n + m) comparisons and O(1) space, so long
+    // literals stay well inside the constexpr step limits. Returns the first
+    // match offset or npos; hay(i) and needle(i) return unsigned bytes.
+    template <typename Hay, typename Needle>
+    static constexpr size_t const_two_way(Hay hay, size_t n, Needle needle, size_t m)
+    {
+        size_t period = 0;
+        size_t suffix = const_critical_factorization(needle, m, period);
+
+        bool periodic = suffix + period <= m;
+        for (size_t i = 0; periodic && i < suffix; ++i)
+        {
+            periodic = needle(i) == needle(i + period);
+        }
+
+        size_t j = 0;
+        if (periodic)
+        {
+            // A mismatch in the left half can only advance by the period, so
+            // remember how much of the right half is already known to match.
+            size_t memory = 0;
+            while (j + m <= n)
+            {
+                size_t i = suffix > memory ? suffix : memory;
+                while (i < m && needle(i) == hay(i + j))
+                {
+                    ++i;
+                }
+                if (i >= m)
+                {
+                    i = suffix - 1;
+                    while (memory < i + 1 && needle(i) == hay(i + j))
+                    {
+                        --i;
+                    }
+                    if (i + 1 < memory + 1)
+                    {
+                        return j;
+                    }
+                    j += period;
+                    memory = m - period;
+                }
+                else
+                {
+                    j += i - suffix + 1;
+                    memory = 0;
+                }
+            }
+        }
+        else
+        {
+            period = (suffix > m - suffix ? suffix : m - suffix) + 1;
+            while (j + m <= n)
+            {
+                size_t i = suffix;
+                while (i < m && needle(i) == hay(i + j))
+                {
+                    ++i;
+                }
+                if (i >= m)
+                {
+                    i = suffix - 1;
+                    while (i != SIZE_MAX && needle(i) == hay(i + j))
+                    {
+                        --i;
+                    }
+                    if (i == SIZE_MAX)
+                    {
+                        return j;
+                    }
+                    j += period;
+                }
+                else
+                {
+                    j += i - suffix + 1;
+                }
+            }
+        }
+        return npos;
     }
 
   public:
+    constexpr TStringConst() : buffer(""), length(0)
+    {
+    }
+
     constexpr TStringConst(const char *str) : buffer(str), length(const_strlen(str))
     {
     }
@@ -589,6 +1229,7 @@ class TStringConst
         return length;
     }
 
+    // Views made by substr or split are not NUL-terminated at size().
     constexpr const char *c_str() const
     {
         return buffer;
@@ -599,19 +1240,24 @@ class TStringConst
         return buffer;
     }
 
+    constexpr int compare(const TStringConst &other) const
+    {
+        return const_compare(buffer, length, other.buffer, other.length);
+    }
+
     constexpr bool operator==(const TStringConst &other) const
     {
-        return const_strcmp(buffer, other.buffer) == 0;
+        return length == other.length && compare(other) == 0;
     }
 
     constexpr bool operator==(const char *str) const
     {
-        return const_strcmp(buffer, str) == 0;
+        return compare(TStringConst(str)) == 0;
     }
 
     constexpr bool operator==(const std::string &str) const
     {
-        return const_strcmp(buffer, str.c_str()) == 0;
+        return length == str.size() && const_compare(buffer, length, str.data(), str.size()) == 0;
     }
 
     constexpr bool operator!=(const TStringConst &other) const
@@ -631,62 +1277,62 @@ class TStringConst
 
     constexpr bool operator<(const TStringConst &other) const
     {
-        return const_strcmp(buffer, other.buffer) < 0;
+        return compare(other) < 0;
     }
 
     constexpr bool operator<(const char *str) const
     {
-        return const_strcmp(buffer, str) < 0;
+        return compare(TStringConst(str)) < 0;
     }
 
     constexpr bool operator<(const std::string &str) const
     {
-        return const_strcmp(buffer, str.c_str()) < 0;
+        return const_compare(buffer, length, str.data(), str.size()) < 0;
     }
 
     constexpr bool operator<=(const TStringConst &other) const
     {
-        return const_strcmp(buffer, other.buffer) <= 0;
+        return compare(other) <= 0;
     }
 
     constexpr bool operator<=(const char *str) const
     {
-        return const_strcmp(buffer, str) <= 0;
+        return compare(TStringConst(str)) <= 0;
     }
 
     constexpr bool operator<=(const std::string &str) const
     {
-        return const_strcmp(buffer, str.c_str()) <= 0;
+        return const_compare(buffer, length, str.data(), str.size()) <= 0;
     }
 
     constexpr bool operator>(const TStringConst &other) const
     {
-        return const_strcmp(buffer, other.buffer) > 0;
+        return compare(other) > 0;
     }
 
     constexpr bool operator>(const char *str) const
     {
-        return const_strcmp(buffer, str) > 0;
+        return compare(TStringConst(str)) > 0;
     }
 
     constexpr bool operator>(const std::string &str) const
     {
-        return const_strcmp(buffer, str.c_str()) > 0;
+        return const_compare(buffer, length, str.data(), str.size()) > 0;
     }
 
     constexpr bool operator>=(const TStringConst &other) const
     {
-        return const_strcmp(buffer, other.buffer) >= 0;
+        return compare(other) >= 0;
     }
 
     constexpr bool operator>=(const char *str) const
     {
-        return const_strcmp(buffer, str) >= 0;
+        return compare(TStringConst(str)) >= 0;
     }
 
     constexpr bool operator>=(const std::string &str) const
     {
-        return const_strcmp(buffer, str.c_str()) >= 0;
+        return const_compare(buffer, length, str.data(), str.size()) >= 0;
     }
 
     constexpr char operator[](size_t index) const
@@ -700,7 +1346,7 @@ class TStringConst
         {
             throw std::out_of_range("Position out of range");
         }
-        size_t actualLen = (pos + len > length) ? (length - pos) : len;
+        size_t actualLen = (len > length - pos) ? (length - pos) : len;
         return TStringConst(buffer + pos, actualLen);
     }
 
@@ -710,42 +1356,162 @@ class TStringConst
         {
             throw std::out_of_range("Position out of range");
         }
-        return TStringConst(buffer + pos);
+        return TStringConst(buffer + pos, length - pos);
     }
 
-    constexpr size_t find(const TStringConst &str) const
+    constexpr size_t find(char ch, size_t pos = 0) const
     {
-        if (str.length == 0)
-            return 0;
-        if (length < str.length)
-            return std::string::npos;
-
-        for (size_t i = 0; i <= length - str.length; ++i)
+        if (pos >= length)
         {
-            if (const_strcmp(buffer + i, str.buffer) == 0)
+            return npos;
+        }
+        if (!std::is_constant_evaluated())
+        {
+            const void *found = std::memchr(buffer + pos, ch, length - pos);
+            return found ? static_cast<const char *>(found) - buffer : npos;
+        }
+        for (size_t i = pos; i < length; ++i)
+        {
+            if (buffer[i] == ch)
+            {
                 return i;
+            }
         }
-        return std::string::npos;
+        return npos;
     }
 
-    std::vector<TStringConst> split(const char delimiter) const
+    constexpr size_t find(const TStringConst &str, size_t pos = 0) const
     {
-        std::vector<TStringConst> result;
-        size_t start = 0;
-        for (size_t i = 0; i < length; ++i)
+        if (pos > length || length - pos < str.length)
         {
-            if (buffer[i] == delimiter)
+            return npos;
+        }
+        if (str.length == 0)
+        {
+            return pos;
+        }
+        const char *hay = buffer + pos;
+        size_t n = length - pos;
+        const char *needle = str.buffer;
+        size_t m = str.length;
+        if (!std::is_constant_evaluated() && m < shortNeedle)
+        {
+            // memchr finds candidates for the first byte, memcmp confirms them.
+            const char *last = hay + (n - m);
+            for (const char *cursor = hay; cursor <= last; ++cursor)
             {
-                if (i > start)
+                cursor = static_cast<const char *>(std::memchr(cursor, needle[0], last - cursor + 1));
+                if (cursor == nullptr)
                 {
-                    result.push_back(substr(start, i - start));
+                    return npos;
+                }
+                if (std::memcmp(cursor + 1, needle + 1, m - 1) == 0)
+                {
+                    return pos + (cursor - hay);
                 }
-                start = i + 1;
             }
+            return npos;
         }
-        if (start < length)
+        size_t found = const_two_way([hay](size_t i) { return static_cast<unsigned char>(hay[i]); }, n,
+                                     [needle](size_t i) { return static_cast<unsigned char>(needle[i]); }, m);
+        return found == npos ? npos : pos + found;
+    }
+
+    constexpr size_t rfind(char ch, size_t pos = npos) const
+    {
+        if (length == 0)
         {
-            result.push_back(substr(start, length - start));
+            return npos;
+        }
+        size_t i = pos < length ? pos : length - 1;
+        for (;; --i)
+        {
+            if (buffer[i] == ch)
+            {
+                return i;
+            }
+            if (i == 0)
+            {
+                return npos;
+            }
+        }
+    }
+
+    // Last occurrence that starts at or before pos.
+    constexpr size_t rfind(const TStringConst &str, size_t pos = npos) const
+    {
+        if (str.length > length)
+        {
+            return npos;
+        }
+        size_t start = length - str.length;
+        if (pos < start)
+        {
+            start = pos;
+        }
+        if (str.length == 0)
+        {
+            return start;
+        }
+        size_t m = str.length;
+        if (!std::is_constant_evaluated() && m < shortNeedle)
+        {
+            return std::string_view(buffer, length).rfind(std::string_view(str.buffer, m), start);
+        }
+        // Search the reversed window with the reversed needle.
+        const char *hay = buffer;
+        const char *needle = str.buffer;
+        size_t last = start + m - 1;
+        size_t found = const_two_way([hay, last](size_t i) { return static_cast<unsigned char>(hay[last - i]); },
+                                     start + m,
+                                     [needle, m](size_t i) { return static_cast<unsigned char>(needle[m - 1 - i]); },
+                                     m);
+        return found == npos ? npos : start - found;
+    }
+
+    constexpr bool starts_with(const TStringConst &str) const
+    {
+        return length >= str.length && const_compare(buffer, str.length, str.buffer, str.length) == 0;
+    }
+
+    constexpr bool starts_with(char ch) const
+    {
+        return length != 0 && buffer[0] == ch;
+    }
+
+    constexpr bool ends_with(const TStringConst &str) const
+    {
+        return length >= str.length &&
+               const_compare(buffer + (length - str.length), str.length, str.buffer, str.length) == 0;
+    }
+
+    constexpr bool ends_with(char ch) const
+    {
+        return length != 0 && buffer[length - 1] == ch;
+    }
+
+    constexpr bool contains(const TStringConst &str) const
+    {
+        return find(str) != npos;
+    }
+
+    // Empty tokens are skipped, like TString::split.
+    constexpr std::vector<TStringConst> split(const char delimiter) const
+    {
+        std::vector<TStringConst> result;
+        size_t start = 0;
+        while (start < length)
+        {
+            size_t end = find(delimiter, start);
+            if (end == npos)
+            {
+                end = length;
+            }
+            if (end > start)
+            {
+                result.push_back(TStringConst(buffer + start, end - start));
+            }
+            start = end + 1;
         }
         return result;
     }
@@ -756,9 +1522,51 @@ class TStringConst
     }
 };
 
-inline TStringConst operator"" _TC(const char *str, size_t)
+constexpr TStringConst operator"" _TC(const char *str, size_t len)
+{
+    return TStringConst(str, len);
+}
+
+// A string computed at compile time, in an array of exactly its length plus the terminator
+template <size_t N> struct TStringFrozen
+{
+    char data[N + 1] = {};
+
+    constexpr size_t size() const
+    {
+        return N;
+    }
+
+    constexpr const char *c_str() const
+    {
+        return data;
+    }
+
+    constexpr TStringConst view() const
+    {
+        return TStringConst(data, N);
+    }
+
+    constexpr operator TStringConst() const
+    {
+        return view();
+    }
+};
+
+// Calls build, a constexpr function returning a TString, at compile time and copies the result into a
+// TStringFrozen. build runs twice, once for the length and once for the bytes:
+//
+//     static constexpr auto key = tstring_freeze<[] { return TString("user:") + "42"; }>();
+template <auto build> consteval auto tstring_freeze()
 {
-    return TStringConst(str);
+    constexpr size_t length = build().size();
+    TStringFrozen<length> frozen;
+    const auto str = build();
+    for (size_t i = 0; i < length; ++i)
+    {
+        frozen.data[i] = str[i];
+    }
+    return frozen;
 }
 
 #endif // TSTRING_HPP
@@ -0,0 +1,257 @@
+#ifndef TSTRING_APPEND_BUFFER_HPP
+#define TSTRING_APPEND_BUFFER_HPP
+
+#include "TString.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// A byte buffer that many threads append to at once, for assembling log
+// output. Writers claim space with one atomic fetch-add on a shared cursor
+// and copy their bytes without taking a lock; the bytes reach the sink in
+// the order the space was claimed, and every append is contiguous.
+//
+// The buffer is a ring of fixed-size segments. The cursor packs the sequence
+// number of the open segment with the write offset inside it, so a claim
+// always names the segment it belongs to. The writer whose claim crosses the
+// end of the segment seals it at its old offset and opens the next one; the
+// writers that claimed past the end wait for that and claim again. A sealed
+// segment is drained once every claim in it has been copied, and only then is
+// it reused, so no writer can ever land in a recycled segment.
+//
+// drain() and flush() pass completed segments to the sink in order. The sink
+// runs on whichever thread drains, never on two threads at once, and must not
+// append to the same buffer. When every segment is full, the writer that
+// needs a new one drains in place, so nothing has to run in the background.
+class TStringAppendBuffer
+{
+  public:
+    using Sink = std::function<void(const char *, size_t)>;
+
+  private:
+    static constexpr unsigned offsetBits = 40;
+    static constexpr uint64_t offsetMask = (uint64_t(1) << offsetBits) - 1;
+    // Segment sequence numbers count modulo 2^24
+    static constexpr uint32_t sequenceMask = (uint32_t(1) << (64 - offsetBits)) - 1;
+    static constexpr size_t open = SIZE_MAX;
+
+    struct alignas(64) Segment
+    {
+        std::unique_ptr<char[]> data;
+        // Bytes copied into the segment
+        std::atomic<size_t> committed{0};
+        // End of the claimed bytes once the segment is sealed, open before
+        std::atomic<size_t> sealed{open};
+        // Sequence number the segment may be opened as next
+        std::atomic<uint32_t> readyFor{0};
+    };
+
+    Sink sink;
+    size_t segmentSize;
+    size_t segmentMask;
+    std::unique_ptr<Segment[]> segments;
+    alignas(64) std::atomic<uint64_t> cursor{0};
+    alignas(64) std::atomic_flag draining = ATOMIC_FLAG_INIT;
+    // Next sequence number to drain, only touched while draining is set
+    uint32_t drainSequence = 0;
+
+    static inline uint32_t sequenceOf(uint64_t position)
+    {
+        return static_cast<uint32_t>(position >> offsetBits) & sequenceMask;
+    }
+
+    inline Segment &segmentFor(uint32_t sequence) const
+    {
+        return segments[sequence & segmentMask];
+    }
+
+    // Seals the segment at end and opens the next one, draining first if the ring is full
+    inline void seal(uint32_t sequence, size_t end)
+    {
+        segmentFor(sequence).sealed.store(end, std::memory_order_release);
+        uint32_t nextSequence = (sequence + 1) & sequenceMask;
+        Segment &next = segmentFor(nextSequence);
+        while (next.readyFor.load(std::memory_order_acquire) != nextSequence)
+        {
+            if (drain() == 0)
+            {
+                std::this_thread::yield();
+            }
+        }
+        cursor.store(uint64_t(nextSequence) << offsetBits, std::memory_order_release);
+    }
+
+  public:
+    // segmentCount is rounded up to a power of two, and at least 2
+    inline explicit TStringAppendBuffer(Sink sink, size_t segmentSize = size_t(1) << 20, size_t segmentCount = 4)
+        : sink(std::move(sink)), segmentSize(segmentSize)
+    {
+        if (segmentSize == 0 || segmentSize > (uint64_t(1) << 32))
+        {
+            throw std::invalid_argument("TStringAppendBuffer segment size must be between 1 byte and 4 GB");
+        }
+        size_t count = 2;
+        while (count < segmentCount)
+        {
+            count *= 2;
+        }
+        segmentMask = count - 1;
+        segments = std::make_unique<Segment[]>(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            segments[i].data = std::make_unique<char[]>(segmentSize);
+            segments[i].readyFor.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    TStringAppendBuffer(const TStringAppendBuffer &) = delete;
+    TStringAppendBuffer &operator=(const TStringAppendBuffer &) = delete;
+
+    // Flushes what is left; no thread may be appending any more
+    inline ~TStringAppendBuffer()
+    {
+        flush();
+    }
+
+    // Thread-safe. Lock-free unless every segment is waiting to be drained.
+    inline void append(const char *str, size_t len)
+    {
+        if (len == 0)
+        {
+            return;
+        }
+        if (len > segmentSize)
+        {
+            throw std::length_error("Append is larger than a TStringAppendBuffer segment");
+        }
+        for (;;)
+        {
+            uint64_t position = cursor.fetch_add(len, std::memory_order_acq_rel);
+            uint32_t sequence = sequenceOf(position);
+            size_t offset = static_cast<size_t>(position & offsetMask);
+            if (offset + len <= segmentSize)
+            {
+                Segment &segment = segmentFor(sequence);
+                std::memcpy(segment.data.get() + offset, str, len);
+                segment.committed.fetch_add(len, std::memory_order_release);
+                return;
+            }
+            if (offset <= segmentSize)
+            {
+                seal(sequence, offset);
+                continue;
+            }
+            while (sequenceOf(cursor.load(std::memory_order_acquire)) == sequence)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    inline void append(const TString &str)
+    {
+        append(str.c_str(), str.size());
+    }
+
+    inline void append(const char *str)
+    {
+        append(str, std::strlen(str));
+    }
+
+    inline void append(const std::string &str)
+    {
+        append(str.data(), str.size());
+    }
+
+    inline void append(std::string_view str)
+    {
+        append(str.data(), str.size());
+    }
+
+    // Passes every sealed segment whose appends have all been copied to the sink,
+    // in order. Returns the bytes drained; 0 also when another thread is draining.
+    inline size_t drain()
+    {
+        if (draining.test_and_set(std::memory_order_acquire))
+        {
+            return 0;
+        }
+        size_t drained = 0;
+        try
+        {
+            for (;;)
+            {
+                Segment &segment = segmentFor(drainSequence);
+                size_t end = segment.sealed.load(std::memory_order_acquire);
+                if (end == open || segment.committed.load(std::memory_order_acquire) != end)
+                {
+                    break;
+                }
+                if (end != 0)
+                {
+                    sink(segment.data.get(), end);
+                }
+                drained += end;
+                // Clear the segment before handing it back, so it doesn't look drainable again
+                segment.committed.store(0, std::memory_order_relaxed);
+                segment.sealed.store(open, std::memory_order_relaxed);
+                segment.readyFor.store((drainSequence + segmentMask + 1) & sequenceMask, std::memory_order_release);
+                drainSequence = (drainSequence + 1) & sequenceMask;
+            }
+        }
+        catch (...)
+        {
+            draining.clear(std::memory_order_release);
+            throw;
+        }
+        draining.clear(std::memory_order_release);
+        return drained;
+    }
+
+    // Seals the open segment and drains everything appended before the call,
+    // waiting for appends that are still copying
+    inline void flush()
+    {
+        uint64_t position = cursor.fetch_add(segmentSize + 1, std::memory_order_acq_rel);
+        uint32_t sequence = sequenceOf(position);
+        size_t offset = static_cast<size_t>(position & offsetMask);
+        if (offset <= segmentSize)
+        {
+            seal(sequence, offset);
+        }
+        else
+        {
+            while (sequenceOf(cursor.load(std::memory_order_acquire)) == sequence)
+            {
+                std::this_thread::yield();
+            }
+        }
+        uint32_t target = (sequence + 1) & sequenceMask;
+        for (;;)
+        {
+            drain();
+            if (!draining.test_and_set(std::memory_order_acquire))
+            {
+                // Sequence numbers wrap; until the target is drained it is at most one ring ahead
+                uint32_t remaining = (target - drainSequence) & sequenceMask;
+                bool reached = remaining == 0 || remaining > segmentMask + 1;
+                draining.clear(std::memory_order_release);
+                if (reached)
+                {
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+};
+
+#endif // TSTRING_APPEND_BUFFER_HPP
@@ -0,0 +1,412 @@
+#ifndef TSTRING_ARCHIVE_HPP
+#define TSTRING_ARCHIVE_HPP
+
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+#include "TStringHash.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Binary file format for string collections that loads without parsing.
+//
+//   header     48 bytes, see TStringArchiveHeader
+//   offsets    count + 1 uint64 values; string i occupies bytes offsets[i]
+//              to offsets[i + 1] - 1 of the bytes section, terminator included
+//   bytes      the strings back to back, each followed by a NUL
+//
+// Numbers are in the byte order of the writing machine, which the header
+// records; other machines refuse the file. The checksum is tstring_hash of
+// the bytes section, seeded with tstring_hash of the offsets table.
+//
+// tstring_save writes a std::vector<TString> or a TStringColumn.
+// TStringArchive maps a file and hands out TStringConst views into it without
+// allocating per string; tstring_load copies every string into a TString in
+// one pass over the file. Errors throw std::runtime_error.
+
+struct TStringArchiveHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t count;
+    // Size of the bytes section, terminators included
+    uint64_t byteCount;
+    uint64_t checksum;
+    // byteOrderMark as written by the producing machine
+    uint32_t byteOrder;
+    uint32_t reserved;
+
+    static constexpr char magicValue[8] = {'T', 'S', 'T', 'R', 'A', 'R', 'C', '\0'};
+    static constexpr uint32_t currentVersion = 1;
+    static constexpr uint32_t byteOrderMark = 0x01020304u;
+    static constexpr uint32_t hasChecksum = 1;
+};
+
+static_assert(sizeof(TStringArchiveHeader) == 48, "TStringArchiveHeader must match the file layout");
+
+// A read-only archive mapped into memory. Elements are views into the
+// mapping and stay valid as long as the archive.
+class TStringArchive
+{
+  private:
+    const char *base = nullptr;
+    size_t mappedSize = 0;
+    // Contents of the file on platforms without mmap
+    std::vector<char> fallback;
+#if defined(_WIN32)
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#endif
+    size_t count = 0;
+    const char *offsets = nullptr;
+    const char *bytes = nullptr;
+    uint64_t byteCount = 0;
+
+    inline uint64_t offsetAt(size_t index) const
+    {
+        uint64_t offset;
+        std::memcpy(&offset, offsets + index * sizeof(uint64_t), sizeof(offset));
+        return offset;
+    }
+
+    inline void map(const std::string &path)
+    {
+#if defined(_WIN32)
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        LARGE_INTEGER size;
+        if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &size))
+        {
+            throw std::runtime_error("Failed to open TString archive " + path);
+        }
+        mappedSize = static_cast<size_t>(size.QuadPart);
+        if (mappedSize == 0)
+        {
+            return;
+        }
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        base = mapping ? static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+        if (base == nullptr)
+        {
+            throw std::runtime_error("Failed to map TString archive " + path);
+        }
+#elif defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd < 0 || ::fstat(fd, &info) != 0)
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+            throw std::runtime_error("Failed to open TString archive " + path);
+        }
+        mappedSize = static_cast<size_t>(info.st_size);
+        void *address = mappedSize ? ::mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0) : nullptr;
+        ::close(fd);
+        if (address == MAP_FAILED)
+        {
+            mappedSize = 0;
+            throw std::runtime_error("Failed to map TString archive " + path);
+        }
+        base = static_cast<const char *>(address);
+#else
+        std::FILE *in = std::fopen(path.c_str(), "rb");
+        if (in == nullptr)
+        {
+            throw std::runtime_error("Failed to open TString archive " + path);
+        }
+        char chunk[65536];
+        size_t read;
+        while ((read = std::fread(chunk, 1, sizeof(chunk), in)) > 0)
+        {
+            fallback.insert(fallback.end(), chunk, chunk + read);
+        }
+        std::fclose(in);
+        base = fallback.data();
+        mappedSize = fallback.size();
+#endif
+    }
+
+    inline void unmap()
+    {
+#if defined(_WIN32)
+        if (base != nullptr)
+        {
+            UnmapViewOfFile(base);
+        }
+        if (mapping != nullptr)
+        {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file);
+        }
+        file = INVALID_HANDLE_VALUE;
+        mapping = nullptr;
+#elif defined(__unix__) || defined(__APPLE__)
+        if (base != nullptr)
+        {
+            ::munmap(const_cast<char *>(base), mappedSize);
+        }
+#endif
+        base = nullptr;
+        mappedSize = 0;
+        fallback.clear();
+    }
+
+    // The header and section sizes are always checked; with verify the offsets
+    // table and the checksum are checked as well, which reads the whole file.
+    inline void validate(const std::string &path, bool verify)
+    {
+        TStringArchiveHeader header;
+        if (mappedSize < sizeof(header))
+        {
+            throw std::runtime_error("TString archive " + path + " is truncated");
+        }
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, TStringArchiveHeader::magicValue, sizeof(header.magic)) != 0)
+        {
+            throw std::runtime_error(path + " is not a TString archive");
+        }
+        if (header.version != TStringArchiveHeader::currentVersion)
+        {
+            throw std::runtime_error("TString archive " + path + " has unsupported version " +
+                                     std::to_string(header.version));
+        }
+        if (header.byteOrder != TStringArchiveHeader::byteOrderMark)
+        {
+            throw std::runtime_error("TString archive " + path + " was written with a different byte order");
+        }
+        size_t available = mappedSize - sizeof(header);
+        if (header.count >= available / sizeof(uint64_t) ||
+            header.byteCount != available - (header.count + 1) * sizeof(uint64_t))
+        {
+            throw std::runtime_error("TString archive " + path + " is truncated");
+        }
+
+        count = static_cast<size_t>(header.count);
+        byteCount = header.byteCount;
+        offsets = base + sizeof(header);
+        bytes = offsets + (count + 1) * sizeof(uint64_t);
+        if (offsetAt(0) != 0 || offsetAt(count) != byteCount)
+        {
+            throw std::runtime_error("TString archive " + path + " has a corrupt offsets table");
+        }
+        if (!verify)
+        {
+            return;
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            uint64_t end = offsetAt(i + 1);
+            if (end <= offsetAt(i) || end > byteCount || bytes[end - 1] != '\0')
+            {
+                throw std::runtime_error("TString archive " + path + " has a corrupt offsets table");
+            }
+        }
+        if ((header.flags & TStringArchiveHeader::hasChecksum) &&
+            tstring_hash(bytes, byteCount, tstring_hash(offsets, (count + 1) * sizeof(uint64_t))) != header.checksum)
+        {
+            throw std::runtime_error("TString archive " + path + " failed its checksum");
+        }
+    }
+
+  public:
+    TStringArchive() = default;
+
+    // Maps the file; see validate for what verify adds to the checks. A failure partway through map leaves
+    // handles open, so map runs inside the try too and unmap closes whatever it got to.
+    inline explicit TStringArchive(const std::string &path, bool verify = true)
+    {
+        try
+        {
+            map(path);
+            validate(path, verify);
+        }
+        catch (...)
+        {
+            unmap();
+            throw;
+        }
+    }
+
+    TStringArchive(const TStringArchive &) = delete;
+    TStringArchive &operator=(const TStringArchive &) = delete;
+
+    inline TStringArchive(TStringArchive &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    inline TStringArchive &operator=(TStringArchive &&other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            bool copied = other.base == other.fallback.data() && other.base != nullptr;
+            fallback = std::move(other.fallback);
+            base = copied ? fallback.data() : other.base;
+            mappedSize = other.mappedSize;
+#if defined(_WIN32)
+            file = other.file;
+            mapping = other.mapping;
+            other.file = INVALID_HANDLE_VALUE;
+            other.mapping = nullptr;
+#endif
+            count = other.count;
+            offsets = base + (other.offsets - other.base);
+            bytes = base + (other.bytes - other.base);
+            byteCount = other.byteCount;
+            other.base = nullptr;
+            other.mappedSize = 0;
+            other.count = 0;
+            other.offsets = nullptr;
+            other.bytes = nullptr;
+            other.byteCount = 0;
+        }
+        return *this;
+    }
+
+    inline ~TStringArchive()
+    {
+        unmap();
+    }
+
+    inline size_t size() const
+    {
+        return count;
+    }
+
+    inline bool empty() const
+    {
+        return count == 0;
+    }
+
+    // Size of the bytes section, terminators included
+    inline size_t byte_size() const
+    {
+        return static_cast<size_t>(byteCount);
+    }
+
+    inline const char *data() const
+    {
+        return bytes;
+    }
+
+    inline TStringConst operator[](size_t index) const
+    {
+        uint64_t offset = offsetAt(index);
+        return TStringConst(bytes + offset, static_cast<size_t>(offsetAt(index + 1) - offset - 1));
+    }
+
+    inline TStringConst at(size_t index) const
+    {
+        if (index >= count)
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+};
+
+namespace tstring_archive_detail
+{
+// Strings is anything with size() and operator[] returning a type with c_str() and size()
+template <typename Strings> inline void save(const std::string &path, const Strings &strings, bool checksum)
+{
+    size_t count = strings.size();
+    std::vector<uint64_t> offsets(count + 1);
+    uint64_t byteCount = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        offsets[i] = byteCount;
+        byteCount += strings[i].size() + 1;
+    }
+    offsets[count] = byteCount;
+
+    std::vector<char> bytes(static_cast<size_t>(byteCount));
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::memcpy(bytes.data() + offsets[i], strings[i].c_str(), strings[i].size());
+        bytes[static_cast<size_t>(offsets[i + 1] - 1)] = '\0';
+    }
+
+    TStringArchiveHeader header = {};
+    std::memcpy(header.magic, TStringArchiveHeader::magicValue, sizeof(header.magic));
+    header.version = TStringArchiveHeader::currentVersion;
+    header.count = count;
+    header.byteCount = byteCount;
+    header.byteOrder = TStringArchiveHeader::byteOrderMark;
+    if (checksum)
+    {
+        header.flags |= TStringArchiveHeader::hasChecksum;
+        const char *table = reinterpret_cast<const char *>(offsets.data());
+        uint64_t tableHash = tstring_hash(table, offsets.size() * sizeof(uint64_t));
+        header.checksum = tstring_hash(bytes.data(), bytes.size(), tableHash);
+    }
+
+    std::FILE *out = std::fopen(path.c_str(), "wb");
+    if (out == nullptr)
+    {
+        throw std::runtime_error("Failed to create TString archive " + path);
+    }
+    bool written = std::fwrite(&header, sizeof(header), 1, out) == 1 &&
+                   std::fwrite(offsets.data(), sizeof(uint64_t), offsets.size(), out) == offsets.size() &&
+                   std::fwrite(bytes.data(), 1, bytes.size(), out) == bytes.size();
+    if (std::fclose(out) != 0 || !written)
+    {
+        throw std::runtime_error("Failed to write TString archive " + path);
+    }
+}
+} // namespace tstring_archive_detail
+
+// Writes the strings to path, replacing the file. Embedded NULs are kept.
+inline void tstring_save(const std::string &path, const std::vector<TString> &strings, bool checksum = true)
+{
+    tstring_archive_detail::save(path, strings, checksum);
+}
+
+inline void tstring_save(const std::string &path, const TStringColumn &column, bool checksum = true)
+{
+    tstring_archive_detail::save(path, column, checksum);
+}
+
+// Reads an archive into TStrings with one allocation per string
+inline std::vector<TString> tstring_load(const std::string &path, bool verify = true)
+{
+    TStringArchive archive(path, verify);
+    std::vector<TString> strings;
+    strings.reserve(archive.size());
+    for (size_t i = 0; i < archive.size(); ++i)
+    {
+        TStringConst view = archive[i];
+        strings.emplace_back(view.c_str(), view.size());
+    }
+    return strings;
+}
+
+#endif // TSTRING_ARCHIVE_HPP
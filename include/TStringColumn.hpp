@@ -0,0 +1,118 @@
+#ifndef TSTRING_COLUMN_HPP
+#define TSTRING_COLUMN_HPP
+
+#include "TString.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// A column of strings stored back to back in one contiguous byte buffer.
+// Every string keeps its NUL terminator, so elements can be handed out as
+// TStringConst views. Reordering a column only permutes the entry table,
+// the bytes themselves never move.
+class TStringColumn
+{
+  private:
+    struct Entry
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    std::vector<char> bytes;
+    std::vector<Entry> entries;
+
+  public:
+    TStringColumn() = default;
+
+    inline void reserve(size_t count, size_t byteCount)
+    {
+        entries.reserve(count);
+        bytes.reserve(byteCount + count);
+    }
+
+    inline void push_back(const char *str, size_t len)
+    {
+        size_t offset = bytes.size();
+        bytes.resize(offset + len + 1);
+        std::memcpy(bytes.data() + offset, str, len);
+        bytes[offset + len] = '\0';
+        entries.push_back({offset, len});
+    }
+
+    inline void push_back(const char *str)
+    {
+        push_back(str, strlen(str));
+    }
+
+    inline void push_back(const TString &str)
+    {
+        push_back(str.c_str(), str.size());
+    }
+
+    inline void push_back(const TStringConst &str)
+    {
+        push_back(str.c_str(), str.size());
+    }
+
+    inline size_t size() const
+    {
+        return entries.size();
+    }
+
+    inline bool empty() const
+    {
+        return entries.empty();
+    }
+
+    inline size_t byte_size() const
+    {
+        return bytes.size();
+    }
+
+    inline const char *data() const
+    {
+        return bytes.data();
+    }
+
+    inline TStringConst operator[](size_t index) const
+    {
+        const Entry &entry = entries[index];
+        return TStringConst(bytes.data() + entry.offset, entry.length);
+    }
+
+    inline TStringConst at(size_t index) const
+    {
+        if (index >= entries.size())
+        {
+            throw std::out_of_range("Index out of range");
+        }
+        return (*this)[index];
+    }
+
+    // Rearranges the elements so that element i becomes the former element order[i].
+    inline void reorder(const std::vector<size_t> &order)
+    {
+        if (order.size() != entries.size())
+        {
+            throw std::invalid_argument("Order size does not match column size");
+        }
+        std::vector<Entry> reordered;
+        reordered.reserve(entries.size());
+        for (size_t index : order)
+        {
+            reordered.push_back(entries[index]);
+        }
+        entries.swap(reordered);
+    }
+
+    inline void clear()
+    {
+        bytes.clear();
+        entries.clear();
+    }
+};
+
+#endif // TSTRING_COLUMN_HPP
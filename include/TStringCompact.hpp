@@ -0,0 +1,206 @@
+#ifndef TSTRING_COMPACT_HPP
+#define TSTRING_COMPACT_HPP
+
+#include "TString.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// A 16-byte string handle for comparison-heavy code: 4-byte length, the first
+// 4 bytes of the string, then either the next 8 bytes (strings up to 12 bytes
+// are stored entirely inline) or a pointer to the full string.
+//
+// Most comparisons are decided by the length and the inline prefix, so they do
+// not dereference the string buffer at all. Long strings are not copied: the
+// handle points into the TString or TStringConst it was made from, which must
+// outlive it.
+class alignas(8) TStringCompact
+{
+  private:
+    static constexpr size_t inlineCapacity = 12;
+
+    uint32_t length;
+    // An inline string whole. A longer one keeps its first 4 bytes here, followed by the pointer to the
+    // string, which is copied in and out with memcpy.
+    char bytes[inlineCapacity];
+
+    inline const char *pointer() const
+    {
+        const char *ptr;
+        std::memcpy(&ptr, bytes + 4, sizeof(ptr));
+        return ptr;
+    }
+
+    static inline uint32_t loadPrefix(const char *bytes)
+    {
+        uint32_t value;
+        std::memcpy(&value, bytes, 4);
+        if constexpr (std::endian::native == std::endian::little)
+        {
+            value = ((value & 0x000000FFu) << 24) | ((value & 0x0000FF00u) << 8) | ((value & 0x00FF0000u) >> 8) |
+                    ((value & 0xFF000000u) >> 24);
+        }
+        return value;
+    }
+
+    inline uint64_t head() const
+    {
+        uint64_t value;
+        std::memcpy(&value, this, 8);
+        return value;
+    }
+
+    inline uint64_t tail() const
+    {
+        uint64_t value;
+        std::memcpy(&value, bytes + 4, 8);
+        return value;
+    }
+
+  public:
+    inline TStringCompact() : length(0), bytes{}
+    {
+    }
+
+    inline TStringCompact(const char *str, size_t len) : bytes{}
+    {
+        if (len > UINT32_MAX)
+        {
+            throw std::length_error("String too long for TStringCompact");
+        }
+        length = static_cast<uint32_t>(len);
+        if (len <= inlineCapacity)
+        {
+            std::memcpy(bytes, str, len);
+        }
+        else
+        {
+            std::memcpy(bytes, str, 4);
+            std::memcpy(bytes + 4, &str, sizeof(str));
+        }
+    }
+
+    inline TStringCompact(const char *str) : TStringCompact(str, strlen(str))
+    {
+    }
+
+    inline TStringCompact(const TString &str) : TStringCompact(str.c_str(), str.size())
+    {
+    }
+
+    inline TStringCompact(const TStringConst &str) : TStringCompact(str.c_str(), str.size())
+    {
+    }
+
+    inline TStringCompact(const std::string &str) : TStringCompact(str.data(), str.size())
+    {
+    }
+
+    inline TStringCompact(std::string_view str) : TStringCompact(str.data(), str.size())
+    {
+    }
+
+    inline size_t size() const
+    {
+        return length;
+    }
+
+    inline bool empty() const
+    {
+        return length == 0;
+    }
+
+    inline bool is_inline() const
+    {
+        return length <= inlineCapacity;
+    }
+
+    // Not NUL-terminated for inline strings.
+    inline const char *data() const
+    {
+        return is_inline() ? bytes : pointer();
+    }
+
+    inline std::string_view view() const
+    {
+        return std::string_view(data(), length);
+    }
+
+    inline explicit operator TString() const
+    {
+        return TString(data(), length);
+    }
+
+    inline int compare(const TStringCompact &other) const
+    {
+        uint32_t lhsPrefix = loadPrefix(bytes);
+        uint32_t rhsPrefix = loadPrefix(other.bytes);
+        if (lhsPrefix != rhsPrefix)
+        {
+            return lhsPrefix < rhsPrefix ? -1 : 1;
+        }
+        size_t common = length < other.length ? length : other.length;
+        if (common > 4)
+        {
+            int result = std::memcmp(data() + 4, other.data() + 4, common - 4);
+            if (result != 0)
+            {
+                return result;
+            }
+        }
+        if (length != other.length)
+        {
+            return length < other.length ? -1 : 1;
+        }
+        return 0;
+    }
+
+    inline bool operator==(const TStringCompact &other) const
+    {
+        if (head() != other.head())
+        {
+            return false;
+        }
+        if (is_inline())
+        {
+            return tail() == other.tail();
+        }
+        const char *lhs = pointer();
+        const char *rhs = other.pointer();
+        return lhs == rhs || std::memcmp(lhs + 4, rhs + 4, length - 4) == 0;
+    }
+
+    inline bool operator!=(const TStringCompact &other) const
+    {
+        return !(*this == other);
+    }
+
+    inline bool operator<(const TStringCompact &other) const
+    {
+        return compare(other) < 0;
+    }
+
+    inline bool operator<=(const TStringCompact &other) const
+    {
+        return compare(other) <= 0;
+    }
+
+    inline bool operator>(const TStringCompact &other) const
+    {
+        return compare(other) > 0;
+    }
+
+    inline bool operator>=(const TStringCompact &other) const
+    {
+        return compare(other) >= 0;
+    }
+};
+
+static_assert(sizeof(TStringCompact) == 16, "TStringCompact must stay 16 bytes");
+static_assert(sizeof(const char *) <= 8, "The pointer of a long string must fit behind its prefix");
+
+#endif // TSTRING_COMPACT_HPP
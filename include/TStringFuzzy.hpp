@@ -0,0 +1,317 @@
+#ifndef TSTRING_FUZZY_HPP
+#define TSTRING_FUZZY_HPP
+
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Levenshtein distance and approximate search with Myers' bit-parallel
+// algorithm, in Hyyrö's formulation: one DP column of the query is held as
+// bit vectors of vertical deltas and advanced by one text byte with a
+// handful of word operations, so the cost is O(n * ceil(m / 64)) instead of
+// the O(n * m) of the textbook matrix, and no matrix is ever allocated.
+// Queries longer than 64 bytes are split into 64-row blocks that pass their
+// horizontal delta on to the next block.
+//
+// A distance bound lets a comparison stop as soon as it can no longer end
+// within the bound: the last row changes by at most one per text byte, so a
+// score that exceeds the bound by more than the bytes left is final.
+
+// An approximate occurrence; pos is npos when there is none
+struct TStringFuzzyMatch
+{
+    size_t pos = TStringConst::npos;
+    size_t length = 0;
+    size_t distance = 0;
+};
+
+// A candidate within the distance bound of a batch search
+struct TStringFuzzyHit
+{
+    size_t index;
+    size_t distance;
+};
+
+namespace tstring_fuzzy_detail
+{
+// Queries up to this many blocks keep their DP column on the stack
+constexpr size_t stackBlocks = 8;
+
+// Advances one block of the column over one text byte. eq has a bit for every
+// row whose query byte equals the text byte, high is the bit of the block's
+// last row, hin the horizontal delta entering the top row. Returns the delta
+// leaving the last row.
+inline int advance(uint64_t &pv, uint64_t &mv, uint64_t eq, uint64_t high, int hin)
+{
+    uint64_t negative = hin < 0 ? 1 : 0;
+    uint64_t xv = eq | mv;
+    eq |= negative;
+    uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+    int hout = static_cast<int>((ph & high) != 0) - static_cast<int>((mh & high) != 0);
+    ph = (ph << 1) | (hin > 0 ? 1 : 0);
+    mh = (mh << 1) | negative;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+    return hout;
+}
+
+// Vertical deltas of one DP column, starting as the first column (all +1)
+class Column
+{
+  public:
+    uint64_t *pv;
+    uint64_t *mv;
+
+    inline explicit Column(size_t blocks) : heap(blocks > stackBlocks ? 2 * blocks : 0)
+    {
+        uint64_t *words = heap.empty() ? local : heap.data();
+        pv = words;
+        mv = words + blocks;
+        for (size_t b = 0; b < blocks; ++b)
+        {
+            pv[b] = ~uint64_t(0);
+            mv[b] = 0;
+        }
+    }
+
+    Column(const Column &) = delete;
+    Column &operator=(const Column &) = delete;
+
+  private:
+    uint64_t local[2 * stackBlocks];
+    std::vector<uint64_t> heap;
+};
+
+// Match masks of a query, peq[ch * blocks + block]
+inline void buildMasks(std::vector<uint64_t> &peq, const char *query, size_t m, size_t blocks, bool reversed)
+{
+    peq.assign(256 * blocks, 0);
+    for (size_t i = 0; i < m; ++i)
+    {
+        unsigned char ch = static_cast<unsigned char>(query[reversed ? m - 1 - i : i]);
+        peq[ch * blocks + i / 64] |= uint64_t(1) << (i % 64);
+    }
+}
+
+// Advances every block over ch; hin is +1 when the top row grows with the text, 0 when matches may start anywhere
+inline int step(Column &column, const uint64_t *peq, size_t blocks, uint64_t lastBit, unsigned char ch, int hin)
+{
+    const uint64_t *eq = peq + ch * blocks;
+    size_t last = blocks - 1;
+    for (size_t b = 0; b < last; ++b)
+    {
+        hin = advance(column.pv[b], column.mv[b], eq[b], uint64_t(1) << 63, hin);
+    }
+    return advance(column.pv[last], column.mv[last], eq[last], lastBit, hin);
+}
+
+// Distance between the query behind peq and text, or maxDistance + 1 once it is certain to exceed maxDistance
+inline size_t distance(const uint64_t *peq, size_t m, size_t blocks, const char *text, size_t n, size_t maxDistance)
+{
+    size_t gap = m > n ? m - n : n - m;
+    if (gap > maxDistance)
+    {
+        return maxDistance + 1;
+    }
+    if (m == 0)
+    {
+        return n;
+    }
+    uint64_t lastBit = uint64_t(1) << ((m - 1) % 64);
+    size_t score = m;
+    if (blocks == 1)
+    {
+        // Keep the column in registers
+        uint64_t pv = ~uint64_t(0);
+        uint64_t mv = 0;
+        for (size_t j = 0; j < n; ++j)
+        {
+            score += advance(pv, mv, peq[static_cast<unsigned char>(text[j])], lastBit, 1);
+            if (score > maxDistance && score - maxDistance > n - j - 1)
+            {
+                return maxDistance + 1;
+            }
+        }
+        return score;
+    }
+    Column column(blocks);
+    for (size_t j = 0; j < n; ++j)
+    {
+        score += step(column, peq, blocks, lastBit, static_cast<unsigned char>(text[j]), 1);
+        if (score > maxDistance && score - maxDistance > n - j - 1)
+        {
+            return maxDistance + 1;
+        }
+    }
+    return score;
+}
+} // namespace tstring_fuzzy_detail
+
+// A query compiled for repeated distance computations and approximate search
+// with at most maxDistance edits. Matching allocates nothing for queries up to
+// 512 bytes.
+class TStringFuzzy
+{
+  private:
+    size_t length;
+    size_t blocks;
+    size_t maxDistance;
+    std::vector<uint64_t> forward;
+    // Masks of the reversed query, to find where an occurrence starts
+    std::vector<uint64_t> backward;
+
+  public:
+    inline explicit TStringFuzzy(const TStringConst &query, size_t maxDistance = SIZE_MAX)
+        : length(query.size()), blocks(query.size() == 0 ? 1 : (query.size() + 63) / 64), maxDistance(maxDistance)
+    {
+        tstring_fuzzy_detail::buildMasks(forward, query.c_str(), length, blocks, false);
+        tstring_fuzzy_detail::buildMasks(backward, query.c_str(), length, blocks, true);
+    }
+
+    inline explicit TStringFuzzy(const TString &query, size_t maxDistance = SIZE_MAX)
+        : TStringFuzzy(TStringConst(query.c_str(), query.size()), maxDistance)
+    {
+    }
+
+    inline explicit TStringFuzzy(const char *query, size_t maxDistance = SIZE_MAX)
+        : TStringFuzzy(TStringConst(query), maxDistance)
+    {
+    }
+
+    // Edit distance to candidate, or maxDistance + 1 when it is larger than maxDistance
+    inline size_t distance(const TStringConst &candidate) const
+    {
+        return tstring_fuzzy_detail::distance(forward.data(), length, blocks, candidate.c_str(), candidate.size(),
+                                              maxDistance);
+    }
+
+    inline size_t distance(const TString &candidate) const
+    {
+        return distance(TStringConst(candidate.c_str(), candidate.size()));
+    }
+
+    // First substring of haystack at or after pos within maxDistance edits of the query. The end is the
+    // first position where the distance drops within the bound, extended while it keeps falling; the
+    // start is the latest one that reaches that distance.
+    inline TStringFuzzyMatch find(const TStringConst &haystack, size_t pos = 0) const
+    {
+        TStringFuzzyMatch match;
+        size_t n = haystack.size();
+        if (pos > n)
+        {
+            return match;
+        }
+        const char *text = haystack.c_str();
+        if (length <= maxDistance)
+        {
+            // Deleting the whole query is already good enough
+            match.pos = pos;
+            match.distance = length;
+            return match;
+        }
+        tstring_fuzzy_detail::Column column(blocks);
+        uint64_t lastBit = uint64_t(1) << ((length - 1) % 64);
+        size_t score = length;
+        size_t end = pos;
+        while (end < n && score > maxDistance)
+        {
+            score += tstring_fuzzy_detail::step(column, forward.data(), blocks, lastBit,
+                                                static_cast<unsigned char>(text[end++]), 0);
+        }
+        if (score > maxDistance)
+        {
+            return match;
+        }
+        while (end < n && score > 0)
+        {
+            int delta = tstring_fuzzy_detail::step(column, forward.data(), blocks, lastBit,
+                                                   static_cast<unsigned char>(text[end]), 0);
+            if (delta >= 0)
+            {
+                break;
+            }
+            score += delta;
+            ++end;
+        }
+
+        // Align the reversed query with the text before end, so the top row is anchored at end
+        tstring_fuzzy_detail::Column reverse(blocks);
+        size_t reach = end - pos < length + score ? end - pos : length + score;
+        size_t reverseScore = length;
+        size_t start = end;
+        for (size_t j = 1; j <= reach && reverseScore != score; ++j)
+        {
+            reverseScore += tstring_fuzzy_detail::step(reverse, backward.data(), blocks, lastBit,
+                                                       static_cast<unsigned char>(text[end - j]), 1);
+            start = end - j;
+        }
+        match.pos = start;
+        match.length = end - start;
+        match.distance = score;
+        return match;
+    }
+
+    inline TStringFuzzyMatch find(const TString &haystack, size_t pos = 0) const
+    {
+        return find(TStringConst(haystack.c_str(), haystack.size()), pos);
+    }
+
+    // Every candidate within maxDistance, in order
+    inline std::vector<TStringFuzzyHit> filter(const TStringColumn &candidates) const
+    {
+        std::vector<TStringFuzzyHit> hits;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            size_t d = distance(candidates[i]);
+            if (d <= maxDistance)
+            {
+                hits.push_back({i, d});
+            }
+        }
+        return hits;
+    }
+
+    inline std::vector<TStringFuzzyHit> filter(const std::vector<TString> &candidates) const
+    {
+        std::vector<TStringFuzzyHit> hits;
+        for (size_t i = 0; i < candidates.size(); ++i)
+        {
+            size_t d = distance(candidates[i]);
+            if (d <= maxDistance)
+            {
+                hits.push_back({i, d});
+            }
+        }
+        return hits;
+    }
+};
+
+// Levenshtein distance between a and b, or maxDistance + 1 once it is certain to be larger. Strings of
+// up to 64 bytes on the shorter side run on the stack; longer ones build the masks of a TStringFuzzy.
+inline size_t tstring_edit_distance(const TStringConst &a, const TStringConst &b, size_t maxDistance = SIZE_MAX)
+{
+    const TStringConst &query = a.size() <= b.size() ? a : b;
+    const TStringConst &text = a.size() <= b.size() ? b : a;
+    if (query.size() > 64)
+    {
+        return TStringFuzzy(query, maxDistance).distance(text);
+    }
+    uint64_t peq[256] = {};
+    for (size_t i = 0; i < query.size(); ++i)
+    {
+        peq[static_cast<unsigned char>(query[i])] |= uint64_t(1) << i;
+    }
+    return tstring_fuzzy_detail::distance(peq, query.size(), 1, text.c_str(), text.size(), maxDistance);
+}
+
+inline size_t tstring_edit_distance(const TString &a, const TString &b, size_t maxDistance = SIZE_MAX)
+{
+    return tstring_edit_distance(TStringConst(a.c_str(), a.size()), TStringConst(b.c_str(), b.size()), maxDistance);
+}
+
+#endif // TSTRING_FUZZY_HPP
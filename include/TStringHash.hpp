@@ -0,0 +1,360 @@
+#ifndef TSTRING_HASH_HPP
+#define TSTRING_HASH_HPP
+
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TSTRING_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define TSTRING_PREFETCH(address) _mm_prefetch(reinterpret_cast<const char *>(address), _MM_HINT_T0)
+#else
+#define TSTRING_PREFETCH(address) ((void)(address))
+#endif
+
+// 64-bit wyhash (final version 4, default secret) and 32-bit FNV-1a for
+// TString keys. Both are constexpr, so hashes of TStringConst literals can be
+// computed at compile time and match the runtime values exactly.
+//
+// The batch forms hash many keys into an output array with the same results
+// as tstring_hash and tstring_hash_fnv; std::hash<TString> is a different
+// function and is not reproduced.
+// Every key lives in its own heap block, so hashing keys one at a time
+// stalls on a cache miss per key once they no longer fit in cache; the batch
+// loop prefetches the key objects and then their bytes a few keys ahead, so
+// the misses overlap with hashing. The wyhash seed premix is computed once
+// per batch instead of once per key.
+class TStringHash
+{
+  private:
+    static constexpr uint64_t secret[4] = {0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+                                           0x4d5a2da51de1aa47ull};
+
+    static constexpr void mum(uint64_t &a, uint64_t &b)
+    {
+#if defined(__SIZEOF_INT128__)
+        __uint128_t r = static_cast<__uint128_t>(a) * b;
+        a = static_cast<uint64_t>(r);
+        b = static_cast<uint64_t>(r >> 64);
+#else
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+        if (!std::is_constant_evaluated())
+        {
+            a = _umul128(a, b, &b);
+            return;
+        }
+#endif
+        uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+        uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb, t = rl + (rm0 << 32);
+        uint64_t c = t < rl;
+        uint64_t lo = t + (rm1 << 32);
+        c += lo < t;
+        uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        a = lo;
+        b = hi;
+#endif
+    }
+
+    static constexpr uint64_t mix(uint64_t a, uint64_t b)
+    {
+        mum(a, b);
+        return a ^ b;
+    }
+
+    static constexpr uint64_t read8(const char *p)
+    {
+        if (std::endian::native == std::endian::little && !std::is_constant_evaluated())
+        {
+            uint64_t value;
+            std::memcpy(&value, p, 8);
+            return value;
+        }
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i)
+        {
+            value = (value << 8) | static_cast<unsigned char>(p[i]);
+        }
+        return value;
+    }
+
+    static constexpr uint64_t read4(const char *p)
+    {
+        if (std::endian::native == std::endian::little && !std::is_constant_evaluated())
+        {
+            uint32_t value;
+            std::memcpy(&value, p, 4);
+            return value;
+        }
+        return uint64_t(static_cast<unsigned char>(p[0])) | uint64_t(static_cast<unsigned char>(p[1])) << 8 |
+               uint64_t(static_cast<unsigned char>(p[2])) << 16 | uint64_t(static_cast<unsigned char>(p[3])) << 24;
+    }
+
+    static constexpr uint64_t read3(const char *p, size_t k)
+    {
+        return (uint64_t(static_cast<unsigned char>(p[0])) << 16) |
+               (uint64_t(static_cast<unsigned char>(p[k >> 1])) << 8) | static_cast<unsigned char>(p[k - 1]);
+    }
+
+    // The seed after the per-call premix, which depends on the seed alone
+    static constexpr uint64_t mixSeed(uint64_t seed)
+    {
+        return seed ^ mix(seed ^ secret[0], secret[1]);
+    }
+
+    static constexpr uint64_t hashBytes(const char *p, size_t len, uint64_t seed)
+    {
+        return hashMixed(p, len, mixSeed(seed));
+    }
+
+    static constexpr uint64_t hashMixed(const char *p, size_t len, uint64_t seed)
+    {
+        uint64_t a, b;
+        if (len <= 16)
+        {
+            if (len >= 4)
+            {
+                a = (read4(p) << 32) | read4(p + ((len >> 3) << 2));
+                b = (read4(p + len - 4) << 32) | read4(p + len - 4 - ((len >> 3) << 2));
+            }
+            else if (len > 0)
+            {
+                a = read3(p, len);
+                b = 0;
+            }
+            else
+            {
+                a = b = 0;
+            }
+        }
+        else
+        {
+            size_t i = len;
+            if (i >= 48)
+            {
+                uint64_t see1 = seed, see2 = seed;
+                do
+                {
+                    seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                    see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+                    see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+                    p += 48;
+                    i -= 48;
+                } while (i >= 48);
+                seed ^= see1 ^ see2;
+            }
+            while (i > 16)
+            {
+                seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+                i -= 16;
+                p += 16;
+            }
+            a = read8(p + i - 16);
+            b = read8(p + i - 8);
+        }
+        a ^= secret[1];
+        b ^= seed;
+        mum(a, b);
+        return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+    }
+
+    // Keys ahead of the current one whose bytes are prefetched; their objects are prefetched twice as far ahead
+    static constexpr size_t prefetchDistance = 8;
+
+    template <typename Key, typename Hash> static inline void hashEach(const Key *keys, size_t count, Hash hash)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i + 2 * prefetchDistance < count)
+            {
+                TSTRING_PREFETCH(keys + i + 2 * prefetchDistance);
+            }
+            if (i + prefetchDistance < count)
+            {
+                TSTRING_PREFETCH(keys[i + prefetchDistance].c_str());
+            }
+            hash(i, keys[i].c_str(), keys[i].size());
+        }
+    }
+
+    template <typename Hash> static inline void hashEach(const TStringColumn &column, Hash hash)
+    {
+        size_t count = column.size();
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (i + prefetchDistance < count)
+            {
+                TSTRING_PREFETCH(column[i + prefetchDistance].c_str());
+            }
+            TStringConst key = column[i];
+            hash(i, key.c_str(), key.size());
+        }
+    }
+
+    static inline void checkOutput(size_t keys, size_t out)
+    {
+        if (out < keys)
+        {
+            throw std::invalid_argument("Hash output is smaller than the number of keys");
+        }
+    }
+
+  public:
+    // Usable in constant expressions, where the bytes are read one at a time.
+    static constexpr uint64_t hash(const char *str, size_t len, uint64_t seed = 0)
+    {
+        return hashBytes(str, len, seed);
+    }
+
+    // 32-bit FNV-1a.
+    static constexpr uint32_t hash_fnv(const char *str, size_t len)
+    {
+        uint32_t value = 2166136261u;
+        for (size_t i = 0; i < len; ++i)
+        {
+            value ^= static_cast<unsigned char>(str[i]);
+            value *= 16777619u;
+        }
+        return value;
+    }
+
+    // out[i] = hash(keys[i], seed) for every key; out must hold at least as many values
+    template <typename Keys> static inline void hash_batch(const Keys &keys, std::span<uint64_t> out, uint64_t seed)
+    {
+        checkOutput(keys.size(), out.size());
+        uint64_t mixed = mixSeed(seed);
+        uint64_t *result = out.data();
+        auto hashOne = [result, mixed](size_t i, const char *str, size_t len) {
+            result[i] = hashMixed(str, len, mixed);
+        };
+        if constexpr (std::is_same_v<Keys, TStringColumn>)
+        {
+            hashEach(keys, hashOne);
+        }
+        else
+        {
+            hashEach(keys.data(), keys.size(), hashOne);
+        }
+    }
+
+    // out[i] = hash_fnv(keys[i]) for every key
+    template <typename Keys> static inline void hash_fnv_batch(const Keys &keys, std::span<uint32_t> out)
+    {
+        checkOutput(keys.size(), out.size());
+        uint32_t *result = out.data();
+        auto hashOne = [result](size_t i, const char *str, size_t len) { result[i] = hash_fnv(str, len); };
+        if constexpr (std::is_same_v<Keys, TStringColumn>)
+        {
+            hashEach(keys, hashOne);
+        }
+        else
+        {
+            hashEach(keys.data(), keys.size(), hashOne);
+        }
+    }
+
+    // Transparent hasher, so containers can look TString keys up by any string type.
+    using is_transparent = void;
+
+    inline size_t operator()(const TString &str) const
+    {
+        return static_cast<size_t>(hash(str.c_str(), str.size()));
+    }
+
+    inline size_t operator()(const TStringConst &str) const
+    {
+        return static_cast<size_t>(hash(str.c_str(), str.size()));
+    }
+
+    inline size_t operator()(const char *str) const
+    {
+        return static_cast<size_t>(hash(str, strlen(str)));
+    }
+
+    inline size_t operator()(std::string_view str) const
+    {
+        return static_cast<size_t>(hash(str.data(), str.size()));
+    }
+
+    inline size_t operator()(const std::string &str) const
+    {
+        return static_cast<size_t>(hash(str.data(), str.size()));
+    }
+};
+
+constexpr uint64_t tstring_hash(const char *str, size_t len, uint64_t seed = 0)
+{
+    return TStringHash::hash(str, len, seed);
+}
+
+constexpr uint64_t tstring_hash(const TStringConst &str, uint64_t seed = 0)
+{
+    return TStringHash::hash(str.c_str(), str.size(), seed);
+}
+
+inline uint64_t tstring_hash(const TString &str, uint64_t seed = 0)
+{
+    return TStringHash::hash(str.c_str(), str.size(), seed);
+}
+
+constexpr uint32_t tstring_hash_fnv(const char *str, size_t len)
+{
+    return TStringHash::hash_fnv(str, len);
+}
+
+constexpr uint32_t tstring_hash_fnv(const TStringConst &str)
+{
+    return TStringHash::hash_fnv(str.c_str(), str.size());
+}
+
+inline uint32_t tstring_hash_fnv(const TString &str)
+{
+    return TStringHash::hash_fnv(str.c_str(), str.size());
+}
+
+// Hashes every key into out, with the same values as tstring_hash
+inline void tstring_hash_batch(std::span<const TString> keys, std::span<uint64_t> out, uint64_t seed = 0)
+{
+    TStringHash::hash_batch(keys, out, seed);
+}
+
+inline void tstring_hash_batch(std::span<const TStringConst> keys, std::span<uint64_t> out, uint64_t seed = 0)
+{
+    TStringHash::hash_batch(keys, out, seed);
+}
+
+inline void tstring_hash_batch(const TStringColumn &keys, std::span<uint64_t> out, uint64_t seed = 0)
+{
+    TStringHash::hash_batch(keys, out, seed);
+}
+
+// Hashes every key into out, with the same values as tstring_hash_fnv
+inline void tstring_hash_fnv_batch(std::span<const TString> keys, std::span<uint32_t> out)
+{
+    TStringHash::hash_fnv_batch(keys, out);
+}
+
+inline void tstring_hash_fnv_batch(std::span<const TStringConst> keys, std::span<uint32_t> out)
+{
+    TStringHash::hash_fnv_batch(keys, out);
+}
+
+inline void tstring_hash_fnv_batch(const TStringColumn &keys, std::span<uint32_t> out)
+{
+    TStringHash::hash_fnv_batch(keys, out);
+}
+
+#endif // TSTRING_HASH_HPP
@@ -0,0 +1,212 @@
+#ifndef TSTRING_INSTRUMENT_HPP
+#define TSTRING_INSTRUMENT_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// Allocation counters for TString, compiled in only when TSTRING_INSTRUMENT is
+// defined (xmake f --instrument=y). TString takes its buffers from std::malloc
+// and frees them with std::free in allocateBuffer and releaseBuffer, and copies
+// bytes with memcpy and memmove in copyBytes and moveBytes. With the macro those
+// helpers report here; without it they call the C functions directly and none
+// of this exists.
+// Strings built during constant evaluation use std::allocator and are never
+// counted.
+//
+// Every thread counts into its own counters, so the hot paths never contend.
+// tstring_thread_stats() reads the calling thread's counters,
+// tstring_global_stats() adds up every live thread and the threads that have
+// already exited. Subtract two snapshots to get the cost of a code path:
+//
+//     TStringAllocationStats before = tstring_thread_stats();
+//     handleRequest(request);
+//     TStringAllocationStats cost = tstring_thread_stats() - before;
+struct TStringAllocationStats
+{
+    // Class k counts buffers of 2^(k-1) + 1 to 2^k bytes; the last class also takes everything larger
+    static constexpr size_t sizeClassCount = 40;
+
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    // Reallocations in append and reserve; each is also counted in allocations and frees
+    uint64_t growths = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t bytesCopied = 0;
+    uint64_t sizeClasses[sizeClassCount] = {};
+
+    static constexpr size_t sizeClassOf(size_t capacity)
+    {
+        size_t sizeClass = capacity <= 1 ? 0 : std::bit_width(capacity - 1);
+        return sizeClass < sizeClassCount ? sizeClass : sizeClassCount - 1;
+    }
+
+    inline TStringAllocationStats &operator+=(const TStringAllocationStats &other)
+    {
+        allocations += other.allocations;
+        frees += other.frees;
+        growths += other.growths;
+        bytesAllocated += other.bytesAllocated;
+        bytesCopied += other.bytesCopied;
+        for (size_t i = 0; i < sizeClassCount; ++i)
+        {
+            sizeClasses[i] += other.sizeClasses[i];
+        }
+        return *this;
+    }
+
+    inline TStringAllocationStats operator-(const TStringAllocationStats &other) const
+    {
+        TStringAllocationStats result = *this;
+        result.allocations -= other.allocations;
+        result.frees -= other.frees;
+        result.growths -= other.growths;
+        result.bytesAllocated -= other.bytesAllocated;
+        result.bytesCopied -= other.bytesCopied;
+        for (size_t i = 0; i < sizeClassCount; ++i)
+        {
+            result.sizeClasses[i] -= other.sizeClasses[i];
+        }
+        return result;
+    }
+};
+
+class TStringInstrument
+{
+  private:
+    // Written only by the owning thread, read by any thread taking a global snapshot
+    struct Counters
+    {
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> frees{0};
+        std::atomic<uint64_t> growths{0};
+        std::atomic<uint64_t> bytesAllocated{0};
+        std::atomic<uint64_t> bytesCopied{0};
+        std::atomic<uint64_t> sizeClasses[TStringAllocationStats::sizeClassCount] = {};
+
+        inline TStringAllocationStats snapshot() const
+        {
+            TStringAllocationStats stats;
+            stats.allocations = allocations.load(std::memory_order_relaxed);
+            stats.frees = frees.load(std::memory_order_relaxed);
+            stats.growths = growths.load(std::memory_order_relaxed);
+            stats.bytesAllocated = bytesAllocated.load(std::memory_order_relaxed);
+            stats.bytesCopied = bytesCopied.load(std::memory_order_relaxed);
+            for (size_t i = 0; i < TStringAllocationStats::sizeClassCount; ++i)
+            {
+                stats.sizeClasses[i] = sizeClasses[i].load(std::memory_order_relaxed);
+            }
+            return stats;
+        }
+    };
+
+    struct Registry
+    {
+        std::mutex mutex;
+        std::vector<const Counters *> live;
+        TStringAllocationStats exited;
+    };
+
+    // Registers itself on the thread's first count and folds into the exited totals when the thread ends
+    struct ThreadCounters
+    {
+        Counters counters;
+
+        inline ThreadCounters()
+        {
+            Registry &shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.live.push_back(&counters);
+        }
+
+        inline ~ThreadCounters()
+        {
+            Registry &shared = registry();
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            shared.exited += counters.snapshot();
+            for (size_t i = 0; i < shared.live.size(); ++i)
+            {
+                if (shared.live[i] == &counters)
+                {
+                    shared.live[i] = shared.live.back();
+                    shared.live.pop_back();
+                    break;
+                }
+            }
+        }
+    };
+
+    static inline Registry &registry()
+    {
+        static Registry shared;
+        return shared;
+    }
+
+    static inline Counters &local()
+    {
+        thread_local ThreadCounters counters;
+        return counters.counters;
+    }
+
+    // Single writer, so a relaxed load and store is enough and avoids a locked add
+    static inline void add(std::atomic<uint64_t> &counter, uint64_t amount)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+  public:
+    static inline void on_allocate(size_t capacity)
+    {
+        Counters &counters = local();
+        add(counters.allocations, 1);
+        add(counters.bytesAllocated, capacity);
+        add(counters.sizeClasses[TStringAllocationStats::sizeClassOf(capacity)], 1);
+    }
+
+    static inline void on_free()
+    {
+        add(local().frees, 1);
+    }
+
+    static inline void on_grow()
+    {
+        add(local().growths, 1);
+    }
+
+    static inline void on_copy(size_t count)
+    {
+        add(local().bytesCopied, count);
+    }
+
+    static inline TStringAllocationStats thread_stats()
+    {
+        return local().snapshot();
+    }
+
+    static inline TStringAllocationStats global_stats()
+    {
+        Registry &shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        TStringAllocationStats stats = shared.exited;
+        for (const Counters *counters : shared.live)
+        {
+            stats += counters->snapshot();
+        }
+        return stats;
+    }
+};
+
+inline TStringAllocationStats tstring_thread_stats()
+{
+    return TStringInstrument::thread_stats();
+}
+
+inline TStringAllocationStats tstring_global_stats()
+{
+    return TStringInstrument::global_stats();
+}
+
+#endif // TSTRING_INSTRUMENT_HPP
@@ -0,0 +1,98 @@
+#ifndef TSTRING_INTEROP_HPP
+#define TSTRING_INTEROP_HPP
+
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Bulk conversions for code that passes batches of strings between TString and
+// std::string. Every output is sized once up front, and every element is
+// copied with its known length, so nothing is measured with strlen or grown
+// element by element.
+//
+// A TString owns a std::malloc block of its own, so a vector of them costs one
+// allocation per element. A TStringColumn keeps all the bytes in a single
+// allocation, which makes it the cheaper target when the strings are only
+// read; views cost no allocation besides the vector.
+
+// One TString per element
+inline std::vector<TString> tstring_from_strings(const std::vector<std::string> &strings)
+{
+    std::vector<TString> result;
+    result.reserve(strings.size());
+    for (const std::string &str : strings)
+    {
+        result.emplace_back(str.data(), str.size());
+    }
+    return result;
+}
+
+// The elements back to back in one column, whose bytes are allocated once
+inline TStringColumn tstring_column_from_strings(const std::vector<std::string> &strings)
+{
+    size_t byteCount = 0;
+    for (const std::string &str : strings)
+    {
+        byteCount += str.size();
+    }
+    TStringColumn column;
+    column.reserve(strings.size(), byteCount);
+    for (const std::string &str : strings)
+    {
+        column.push_back(str.data(), str.size());
+    }
+    return column;
+}
+
+inline std::vector<std::string> tstring_to_strings(const std::vector<TString> &strings)
+{
+    std::vector<std::string> result;
+    result.reserve(strings.size());
+    for (const TString &str : strings)
+    {
+        result.emplace_back(str.c_str(), str.size());
+    }
+    return result;
+}
+
+inline std::vector<std::string> tstring_to_strings(const TStringColumn &column)
+{
+    std::vector<std::string> result;
+    result.reserve(column.size());
+    for (size_t i = 0; i < column.size(); ++i)
+    {
+        TStringConst str = column[i];
+        result.emplace_back(str.c_str(), str.size());
+    }
+    return result;
+}
+
+// Views of the elements, valid while the strings are neither changed nor destroyed
+inline std::vector<std::string_view> tstring_views(const std::vector<TString> &strings)
+{
+    std::vector<std::string_view> result;
+    result.reserve(strings.size());
+    for (const TString &str : strings)
+    {
+        result.emplace_back(str.c_str(), str.size());
+    }
+    return result;
+}
+
+inline std::vector<std::string_view> tstring_views(const TStringColumn &column)
+{
+    std::vector<std::string_view> result;
+    result.reserve(column.size());
+    for (size_t i = 0; i < column.size(); ++i)
+    {
+        TStringConst str = column[i];
+        result.emplace_back(str.c_str(), str.size());
+    }
+    return result;
+}
+
+#endif // TSTRING_INTEROP_HPP
@@ -0,0 +1,574 @@
+#ifndef TSTRING_MAP_HPP
+#define TSTRING_MAP_HPP
+
+#include "TString.hpp"
+#include "TStringHash.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TSTRING_MAP_SSE2
+#endif
+
+// Open-addressing hash map keyed by strings, laid out like a SwissTable: one
+// control byte per slot holding 7 bits of the hash, probed 16 slots at a time.
+// Every slot also stores the full 64-bit hash, so key bytes are only compared
+// on a real hash match and growing never rehashes keys.
+//
+// Lookups accept TString, TStringConst, std::string, std::string_view and
+// const char * without building a TString. With ArenaKeys set, keys are copied
+// into an internal arena and exposed as TStringConst instead of owning one
+// allocation per key; erased keys are only reclaimed by clear().
+template <typename V, bool ArenaKeys = false> class TStringMap
+{
+  public:
+    using key_type = std::conditional_t<ArenaKeys, TStringConst, TString>;
+    using mapped_type = V;
+
+    struct Entry
+    {
+        key_type key;
+        V value;
+    };
+
+  private:
+    static constexpr int8_t ctrlEmpty = -128;
+    static constexpr int8_t ctrlDeleted = -2;
+    static constexpr size_t groupWidth = 16;
+    static constexpr size_t arenaChunkSize = 64 * 1024;
+
+    struct Slot
+    {
+        uint64_t hash;
+        alignas(Entry) unsigned char storage[sizeof(Entry)];
+
+        inline Entry *entry()
+        {
+            return std::launder(reinterpret_cast<Entry *>(storage));
+        }
+    };
+
+    struct Group
+    {
+#ifdef TSTRING_MAP_SSE2
+        __m128i ctrl;
+
+        inline explicit Group(const int8_t *pos) : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos)))
+        {
+        }
+
+        inline uint32_t match(int8_t h2) const
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+        }
+
+        inline uint32_t matchEmpty() const
+        {
+            return match(ctrlEmpty);
+        }
+
+        inline uint32_t matchEmptyOrDeleted() const
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), ctrl)));
+        }
+#else
+        const int8_t *ctrl;
+
+        inline explicit Group(const int8_t *pos) : ctrl(pos)
+        {
+        }
+
+        inline uint32_t match(int8_t h2) const
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < groupWidth; ++i)
+            {
+                mask |= uint32_t(ctrl[i] == h2) << i;
+            }
+            return mask;
+        }
+
+        inline uint32_t matchEmpty() const
+        {
+            return match(ctrlEmpty);
+        }
+
+        inline uint32_t matchEmptyOrDeleted() const
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < groupWidth; ++i)
+            {
+                mask |= uint32_t(ctrl[i] < -1) << i;
+            }
+            return mask;
+        }
+#endif
+    };
+
+    struct KeyView
+    {
+        const char *data;
+        size_t length;
+    };
+
+    int8_t *ctrl = nullptr;
+    Slot *slots = nullptr;
+    size_t capacity = 0;
+    size_t count = 0;
+    size_t tombstones = 0;
+    std::vector<std::unique_ptr<char[]>> arena;
+    size_t arenaUsed = arenaChunkSize;
+
+    static inline KeyView view(const TString &key)
+    {
+        return {key.c_str(), key.size()};
+    }
+
+    static inline KeyView view(const TStringConst &key)
+    {
+        return {key.c_str(), key.size()};
+    }
+
+    static inline KeyView view(const std::string &key)
+    {
+        return {key.data(), key.size()};
+    }
+
+    static inline KeyView view(std::string_view key)
+    {
+        return {key.data(), key.size()};
+    }
+
+    static inline KeyView view(const char *key)
+    {
+        return {key, strlen(key)};
+    }
+
+    static inline int8_t h2(uint64_t hash)
+    {
+        return static_cast<int8_t>(hash & 0x7F);
+    }
+
+    static inline size_t h1(uint64_t hash)
+    {
+        return static_cast<size_t>(hash >> 7);
+    }
+
+    inline size_t groupMask() const
+    {
+        return capacity / groupWidth - 1;
+    }
+
+    inline bool keyEquals(Slot &slot, uint64_t hash, KeyView key)
+    {
+        if (slot.hash != hash)
+        {
+            return false;
+        }
+        const key_type &stored = slot.entry()->key;
+        return stored.size() == key.length && std::memcmp(stored.c_str(), key.data, key.length) == 0;
+    }
+
+    size_t findIndex(KeyView key, uint64_t hash) const
+    {
+        if (capacity == 0)
+        {
+            return SIZE_MAX;
+        }
+        size_t mask = groupMask();
+        size_t group = h1(hash) & mask;
+        for (size_t step = 1;; ++step)
+        {
+            Group g(ctrl + group * groupWidth);
+            for (uint32_t bits = g.match(h2(hash)); bits != 0; bits &= bits - 1)
+            {
+                size_t index = group * groupWidth + std::countr_zero(bits);
+                if (const_cast<TStringMap *>(this)->keyEquals(slots[index], hash, key))
+                {
+                    return index;
+                }
+            }
+            if (g.matchEmpty() != 0)
+            {
+                return SIZE_MAX;
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    size_t findInsertSlot(uint64_t hash) const
+    {
+        size_t mask = groupMask();
+        size_t group = h1(hash) & mask;
+        for (size_t step = 1;; ++step)
+        {
+            uint32_t bits = Group(ctrl + group * groupWidth).matchEmptyOrDeleted();
+            if (bits != 0)
+            {
+                return group * groupWidth + std::countr_zero(bits);
+            }
+            group = (group + step) & mask;
+        }
+    }
+
+    key_type makeKey(KeyView key)
+    {
+        if constexpr (ArenaKeys)
+        {
+            size_t needed = key.length + 1;
+            if (needed > arenaChunkSize)
+            {
+                arena.emplace_back(new char[needed]);
+                char *copy = arena.back().get();
+                std::memcpy(copy, key.data, key.length);
+                copy[key.length] = '\0';
+                if (arena.size() > 1)
+                {
+                    std::swap(arena[arena.size() - 1], arena[arena.size() - 2]);
+                }
+                return TStringConst(copy, key.length);
+            }
+            if (arenaUsed + needed > arenaChunkSize)
+            {
+                arena.emplace_back(new char[arenaChunkSize]);
+                arenaUsed = 0;
+            }
+            char *copy = arena.back().get() + arenaUsed;
+            arenaUsed += needed;
+            std::memcpy(copy, key.data, key.length);
+            copy[key.length] = '\0';
+            return TStringConst(copy, key.length);
+        }
+        else
+        {
+            return TString(key.data, key.length);
+        }
+    }
+
+    void destroyAll()
+    {
+        for (size_t i = 0; i < capacity; ++i)
+        {
+            if (ctrl[i] >= 0)
+            {
+                slots[i].entry()->~Entry();
+            }
+        }
+    }
+
+    void release()
+    {
+        if (capacity != 0)
+        {
+            destroyAll();
+            delete[] ctrl;
+            std::allocator<Slot>().deallocate(slots, capacity);
+        }
+        ctrl = nullptr;
+        slots = nullptr;
+        capacity = 0;
+        count = 0;
+        tombstones = 0;
+    }
+
+    void rehash(size_t newCapacity)
+    {
+        int8_t *oldCtrl = ctrl;
+        Slot *oldSlots = slots;
+        size_t oldCapacity = capacity;
+
+        ctrl = new int8_t[newCapacity];
+        std::memset(ctrl, static_cast<unsigned char>(ctrlEmpty), newCapacity);
+        slots = std::allocator<Slot>().allocate(newCapacity);
+        capacity = newCapacity;
+        tombstones = 0;
+
+        for (size_t i = 0; i < oldCapacity; ++i)
+        {
+            if (oldCtrl[i] >= 0)
+            {
+                Slot &from = oldSlots[i];
+                size_t index = findInsertSlot(from.hash);
+                ctrl[index] = h2(from.hash);
+                slots[index].hash = from.hash;
+                new (slots[index].storage) Entry(std::move(*from.entry()));
+                from.entry()->~Entry();
+            }
+        }
+        if (oldCapacity != 0)
+        {
+            delete[] oldCtrl;
+            std::allocator<Slot>().deallocate(oldSlots, oldCapacity);
+        }
+    }
+
+    static inline size_t capacityFor(size_t entries)
+    {
+        size_t needed = entries + entries / 7 + 1;
+        size_t result = groupWidth;
+        while (result < needed)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+
+    template <typename... Args> std::pair<V *, bool> emplaceView(KeyView key, Args &&...args)
+    {
+        uint64_t hash = TStringHash::hash(key.data, key.length);
+        size_t index = findIndex(key, hash);
+        if (index != SIZE_MAX)
+        {
+            return {&slots[index].entry()->value, false};
+        }
+        // Keep the load factor (tombstones included) at or below 7/8.
+        if (capacity == 0 || (count + tombstones + 1) * 8 > capacity * 7)
+        {
+            rehash(count * 2 + 2 > capacity ? capacityFor(count * 2 + 2) : capacity);
+        }
+        index = findInsertSlot(hash);
+        if (ctrl[index] == ctrlDeleted)
+        {
+            --tombstones;
+        }
+        Slot &slot = slots[index];
+        slot.hash = hash;
+        new (slot.storage) Entry{makeKey(key), V(std::forward<Args>(args)...)};
+        ctrl[index] = h2(hash);
+        ++count;
+        return {&slot.entry()->value, true};
+    }
+
+  public:
+    class iterator
+    {
+      private:
+        TStringMap *map;
+        size_t index;
+
+        inline void skip()
+        {
+            while (index < map->capacity && map->ctrl[index] < 0)
+            {
+                ++index;
+            }
+        }
+
+      public:
+        inline iterator(TStringMap *owner, size_t position) : map(owner), index(position)
+        {
+            skip();
+        }
+
+        inline Entry &operator*() const
+        {
+            return *map->slots[index].entry();
+        }
+
+        inline Entry *operator->() const
+        {
+            return map->slots[index].entry();
+        }
+
+        inline iterator &operator++()
+        {
+            ++index;
+            skip();
+            return *this;
+        }
+
+        inline bool operator==(const iterator &other) const
+        {
+            return index == other.index;
+        }
+
+        inline bool operator!=(const iterator &other) const
+        {
+            return index != other.index;
+        }
+    };
+
+    TStringMap() = default;
+
+    inline explicit TStringMap(size_t expected)
+    {
+        reserve(expected);
+    }
+
+    inline TStringMap(const TStringMap &other)
+    {
+        reserve(other.count);
+        for (size_t i = 0; i < other.capacity; ++i)
+        {
+            if (other.ctrl[i] >= 0)
+            {
+                const Entry &entry = *const_cast<Slot &>(other.slots[i]).entry();
+                emplaceView({entry.key.c_str(), entry.key.size()}, entry.value);
+            }
+        }
+    }
+
+    inline TStringMap(TStringMap &&other) noexcept
+        : ctrl(other.ctrl), slots(other.slots), capacity(other.capacity), count(other.count),
+          tombstones(other.tombstones), arena(std::move(other.arena)), arenaUsed(other.arenaUsed)
+    {
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.capacity = 0;
+        other.count = 0;
+        other.tombstones = 0;
+        other.arenaUsed = arenaChunkSize;
+    }
+
+    inline TStringMap &operator=(const TStringMap &other)
+    {
+        if (this != &other)
+        {
+            TStringMap copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    inline TStringMap &operator=(TStringMap &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            ctrl = other.ctrl;
+            slots = other.slots;
+            capacity = other.capacity;
+            count = other.count;
+            tombstones = other.tombstones;
+            arena = std::move(other.arena);
+            arenaUsed = other.arenaUsed;
+            other.ctrl = nullptr;
+            other.slots = nullptr;
+            other.capacity = 0;
+            other.count = 0;
+            other.tombstones = 0;
+            other.arenaUsed = arenaChunkSize;
+        }
+        return *this;
+    }
+
+    inline ~TStringMap()
+    {
+        release();
+    }
+
+    inline size_t size() const
+    {
+        return count;
+    }
+
+    inline bool empty() const
+    {
+        return count == 0;
+    }
+
+    inline size_t bucket_count() const
+    {
+        return capacity;
+    }
+
+    inline void reserve(size_t expected)
+    {
+        size_t wanted = capacityFor(expected);
+        if (wanted > capacity)
+        {
+            rehash(wanted);
+        }
+    }
+
+    inline void clear()
+    {
+        release();
+        arena.clear();
+        arenaUsed = arenaChunkSize;
+    }
+
+    template <typename Key> inline V *find(const Key &key)
+    {
+        KeyView k = view(key);
+        size_t index = findIndex(k, TStringHash::hash(k.data, k.length));
+        return index == SIZE_MAX ? nullptr : &slots[index].entry()->value;
+    }
+
+    template <typename Key> inline const V *find(const Key &key) const
+    {
+        return const_cast<TStringMap *>(this)->find(key);
+    }
+
+    template <typename Key> inline bool contains(const Key &key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    template <typename Key> inline std::pair<V *, bool> insert(const Key &key, const V &value)
+    {
+        return emplaceView(view(key), value);
+    }
+
+    template <typename Key> inline std::pair<V *, bool> insert(const Key &key, V &&value)
+    {
+        return emplaceView(view(key), std::move(value));
+    }
+
+    template <typename Key, typename... Args> inline std::pair<V *, bool> emplace(const Key &key, Args &&...args)
+    {
+        return emplaceView(view(key), std::forward<Args>(args)...);
+    }
+
+    template <typename Key> inline V &operator[](const Key &key)
+    {
+        return *emplaceView(view(key)).first;
+    }
+
+    template <typename Key> inline bool erase(const Key &key)
+    {
+        KeyView k = view(key);
+        size_t index = findIndex(k, TStringHash::hash(k.data, k.length));
+        if (index == SIZE_MAX)
+        {
+            return false;
+        }
+        slots[index].entry()->~Entry();
+        // A group that still has an empty slot never made a probe continue past it,
+        // so the slot can become empty again instead of a tombstone.
+        size_t groupStart = index & ~(groupWidth - 1);
+        if (Group(ctrl + groupStart).matchEmpty() != 0)
+        {
+            ctrl[index] = ctrlEmpty;
+        }
+        else
+        {
+            ctrl[index] = ctrlDeleted;
+            ++tombstones;
+        }
+        --count;
+        return true;
+    }
+
+    inline iterator begin()
+    {
+        return iterator(this, 0);
+    }
+
+    inline iterator end()
+    {
+        return iterator(this, capacity);
+    }
+};
+
+#endif // TSTRING_MAP_HPP
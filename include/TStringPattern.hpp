@@ -0,0 +1,385 @@
+#ifndef TSTRING_PATTERN_HPP
+#define TSTRING_PATTERN_HPP
+
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// A wildcard pattern, compiled once and matched against whole strings:
+//
+//     *        any run of bytes, including none
+//     ?        any single byte
+//     [abc]    one of the listed bytes; [a-z] is a range, [!a-z] or [^a-z] the complement
+//     \x       the byte x itself, also inside a class
+//
+// Matching never backtracks. The stars split the pattern into segments of
+// fixed length: the first must match at the start of the string, the last at
+// the end, and the ones in between are taken at their leftmost occurrence,
+// which is always safe because a star absorbs whatever lies between them. A segment of plain bytes is found with
+// TStringConst::find; a segment with ? or a class is found with a Shift-And
+// automaton, one pass over the string, and skips to candidates with memchr
+// when it starts with a plain byte. The automaton keeps one word per 64
+// positions of the segment and carries the top bit of each word into the
+// next; its state lives on the stack up to 512 positions and is allocated
+// beyond that.
+class TStringPattern
+{
+  private:
+    using ByteSet = std::array<uint64_t, 4>;
+
+    // Segments up to this many words of 64 positions keep their automaton state on the stack
+    static constexpr size_t stackWords = 8;
+
+    struct Segment
+    {
+        // The bytes of the segment; only meaningful when literal
+        TString text;
+        bool literal = true;
+        // First position as a plain byte, -1 when it is ? or a class
+        int firstByte = -1;
+        // One byte set per position, kept unless literal
+        std::vector<ByteSet> sets;
+        // Shift-And masks of 64 positions each, masks[ch * words + word]; only when not literal
+        std::vector<uint64_t> masks;
+        size_t words = 0;
+    };
+
+    std::vector<Segment> segments;
+    // Whether the pattern has a star at all; without one, the only segment spans the whole string
+    bool starred = false;
+    size_t minLength = 0;
+
+    static inline bool contains(const ByteSet &set, unsigned char ch)
+    {
+        return (set[ch >> 6] >> (ch & 63)) & 1;
+    }
+
+    static inline void insert(ByteSet &set, unsigned char ch)
+    {
+        set[ch >> 6] |= uint64_t(1) << (ch & 63);
+    }
+
+    inline void closeSegment(Segment &segment)
+    {
+        size_t len = segment.text.size();
+        if (segment.literal)
+        {
+            segment.sets.clear();
+        }
+        else
+        {
+            size_t words = (len + 63) / 64;
+            segment.words = words;
+            segment.masks.assign(256 * words, 0);
+            for (size_t i = 0; i < len; ++i)
+            {
+                for (unsigned ch = 0; ch < 256; ++ch)
+                {
+                    if (contains(segment.sets[i], static_cast<unsigned char>(ch)))
+                    {
+                        segment.masks[ch * words + i / 64] |= uint64_t(1) << (i % 64);
+                    }
+                }
+            }
+        }
+        minLength += len;
+        segments.push_back(std::move(segment));
+        segment = Segment();
+    }
+
+    static inline ByteSet single(char ch)
+    {
+        ByteSet set = {};
+        insert(set, static_cast<unsigned char>(ch));
+        return set;
+    }
+
+    // Parses the class starting after '[' and returns the position after its ']'
+    static inline size_t parseClass(const TStringConst &pattern, size_t pos, ByteSet &set)
+    {
+        bool negate = pos < pattern.size() && (pattern[pos] == '!' || pattern[pos] == '^');
+        if (negate)
+        {
+            ++pos;
+        }
+        bool first = true;
+        for (;;)
+        {
+            if (pos >= pattern.size())
+            {
+                throw std::invalid_argument("Unterminated character class in pattern");
+            }
+            char ch = pattern[pos++];
+            if (ch == ']' && !first)
+            {
+                break;
+            }
+            first = false;
+            if (ch == '\\' && pos < pattern.size())
+            {
+                ch = pattern[pos++];
+            }
+            unsigned char low = static_cast<unsigned char>(ch);
+            unsigned char high = low;
+            if (pos + 1 < pattern.size() && pattern[pos] == '-' && pattern[pos + 1] != ']')
+            {
+                char last = pattern[pos + 1];
+                pos += 2;
+                if (last == '\\' && pos < pattern.size())
+                {
+                    last = pattern[pos++];
+                }
+                high = static_cast<unsigned char>(last);
+            }
+            for (unsigned value = low; value <= high; ++value)
+            {
+                insert(set, static_cast<unsigned char>(value));
+            }
+        }
+        if (negate)
+        {
+            for (uint64_t &word : set)
+            {
+                word = ~word;
+            }
+        }
+        return pos;
+    }
+
+    static inline bool matchAt(const Segment &segment, const char *str)
+    {
+        size_t len = segment.text.size();
+        if (segment.literal)
+        {
+            return len == 0 || std::memcmp(str, segment.text.c_str(), len) == 0;
+        }
+        for (size_t i = 0; i < len; ++i)
+        {
+            if (!contains(segment.sets[i], static_cast<unsigned char>(str[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Leftmost start of the segment in str at or after pos, or npos
+    static inline size_t find(const Segment &segment, const TStringConst &str, size_t pos)
+    {
+        size_t len = segment.text.size();
+        if (segment.literal)
+        {
+            return str.find(TStringConst(segment.text.c_str(), len), pos);
+        }
+        const char *data = str.c_str();
+        size_t n = str.size();
+        const uint64_t *masks = segment.masks.data();
+        size_t words = segment.words;
+        if (words == 1)
+        {
+            uint64_t found = uint64_t(1) << (len - 1);
+            uint64_t state = 0;
+            for (size_t i = pos; i < n; ++i)
+            {
+                if (state == 0 && segment.firstByte >= 0 && !skipTo(segment, data, n, i))
+                {
+                    break;
+                }
+                state = ((state << 1) | 1) & masks[static_cast<unsigned char>(data[i])];
+                if (state & found)
+                {
+                    return i + 1 - len;
+                }
+            }
+            return TStringConst::npos;
+        }
+
+        uint64_t local[stackWords] = {};
+        std::vector<uint64_t> heap(words > stackWords ? words : 0);
+        uint64_t *state = heap.empty() ? local : heap.data();
+        uint64_t found = uint64_t(1) << ((len - 1) % 64);
+        uint64_t active = 0;
+        for (size_t i = pos; i < n; ++i)
+        {
+            if (active == 0 && segment.firstByte >= 0 && !skipTo(segment, data, n, i))
+            {
+                break;
+            }
+            const uint64_t *mask = masks + static_cast<unsigned char>(data[i]) * words;
+            uint64_t carry = 1;
+            active = 0;
+            for (size_t w = 0; w < words; ++w)
+            {
+                uint64_t shifted = (state[w] << 1) | carry;
+                carry = state[w] >> 63;
+                state[w] = shifted & mask[w];
+                active |= state[w];
+            }
+            if (state[words - 1] & found)
+            {
+                return i + 1 - len;
+            }
+        }
+        return TStringConst::npos;
+    }
+
+    // Moves i to the next occurrence of the segment's first byte; false when there is none
+    static inline bool skipTo(const Segment &segment, const char *data, size_t n, size_t &i)
+    {
+        const void *next = std::memchr(data + i, segment.firstByte, n - i);
+        if (next == nullptr)
+        {
+            return false;
+        }
+        i = static_cast<size_t>(static_cast<const char *>(next) - data);
+        return true;
+    }
+
+  public:
+    // Throws std::invalid_argument on an unterminated class
+    inline explicit TStringPattern(const TStringConst &pattern)
+    {
+        Segment segment;
+        size_t pos = 0;
+        while (pos < pattern.size())
+        {
+            char ch = pattern[pos++];
+            if (ch == '*')
+            {
+                closeSegment(segment);
+                starred = true;
+                continue;
+            }
+            ByteSet set = {};
+            bool plain = false;
+            if (ch == '?')
+            {
+                set.fill(~uint64_t(0));
+            }
+            else if (ch == '[')
+            {
+                pos = parseClass(pattern, pos, set);
+            }
+            else
+            {
+                if (ch == '\\' && pos < pattern.size())
+                {
+                    ch = pattern[pos++];
+                }
+                set = single(ch);
+                plain = true;
+            }
+            if (segment.text.empty() && plain)
+            {
+                segment.firstByte = static_cast<unsigned char>(ch);
+            }
+            segment.literal = segment.literal && plain;
+            // ? and classes hold a placeholder byte, so positions line up with the sets
+            segment.text.push_back(plain ? ch : '\0');
+            segment.sets.push_back(set);
+        }
+        closeSegment(segment);
+    }
+
+    inline explicit TStringPattern(const char *pattern) : TStringPattern(TStringConst(pattern))
+    {
+    }
+
+    // Whether the whole of str matches the pattern
+    inline bool match(const TStringConst &str) const
+    {
+        size_t n = str.size();
+        if (n < minLength || (!starred && n != minLength))
+        {
+            return false;
+        }
+        const char *data = str.c_str();
+        const Segment &head = segments.front();
+        const Segment &tail = segments.back();
+        if (!matchAt(head, data))
+        {
+            return false;
+        }
+        if (!starred)
+        {
+            return true;
+        }
+        if (!matchAt(tail, data + n - tail.text.size()))
+        {
+            return false;
+        }
+        // Middle segments lie between the head and the tail, leftmost first
+        TStringConst middle(data, n - tail.text.size());
+        size_t pos = head.text.size();
+        for (size_t i = 1; i + 1 < segments.size(); ++i)
+        {
+            const Segment &segment = segments[i];
+            if (segment.text.empty())
+            {
+                continue;
+            }
+            size_t found = find(segment, middle, pos);
+            if (found == TStringConst::npos)
+            {
+                return false;
+            }
+            pos = found + segment.text.size();
+        }
+        return true;
+    }
+
+    inline bool match(const TString &str) const
+    {
+        return match(TStringConst(str.c_str(), str.size()));
+    }
+
+    inline bool match(const char *str) const
+    {
+        return match(TStringConst(str));
+    }
+
+    inline bool operator()(const TStringConst &str) const
+    {
+        return match(str);
+    }
+
+    inline bool operator()(const TString &str) const
+    {
+        return match(str);
+    }
+
+    // Indices of the matching elements, in order
+    inline std::vector<size_t> filter(const TStringColumn &column) const
+    {
+        std::vector<size_t> matches;
+        for (size_t i = 0; i < column.size(); ++i)
+        {
+            if (match(column[i]))
+            {
+                matches.push_back(i);
+            }
+        }
+        return matches;
+    }
+
+    inline std::vector<size_t> filter(const std::vector<TString> &strings) const
+    {
+        std::vector<size_t> matches;
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            if (match(strings[i]))
+            {
+                matches.push_back(i);
+            }
+        }
+        return matches;
+    }
+};
+
+#endif // TSTRING_PATTERN_HPP
@@ -0,0 +1,384 @@
+#ifndef TSTRING_SORT_HPP
+#define TSTRING_SORT_HPP
+
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Sorts string collections in byte-lexicographic order, which is the order
+// TString::operator< produces for strings without embedded NULs.
+//
+// Large buckets are split with an MSD radix pass on the next byte, small
+// buckets are finished with a multikey quicksort. Every item carries the next
+// 8 bytes of its string as a big-endian integer, so both passes mostly work
+// on the cached key and only touch string memory once per 8 bytes of depth.
+// The top-level buckets are sorted in parallel for large inputs.
+class TStringSorter
+{
+  private:
+    struct Item
+    {
+        uint64_t key;
+        const unsigned char *str;
+        size_t length;
+        size_t index;
+    };
+
+    static constexpr size_t insertionThreshold = 16;
+    static constexpr size_t quicksortThreshold = 1024;
+    static constexpr size_t parallelThreshold = 1 << 16;
+
+    unsigned threadCount;
+
+    static inline uint64_t loadKey(const unsigned char *str, size_t length, size_t depth)
+    {
+        if (depth + 8 <= length)
+        {
+            uint64_t value;
+            std::memcpy(&value, str + depth, 8);
+            if constexpr (std::endian::native == std::endian::little)
+            {
+#if defined(_MSC_VER) && !defined(__clang__)
+                value = _byteswap_uint64(value);
+#else
+                value = __builtin_bswap64(value);
+#endif
+            }
+            return value;
+        }
+        uint64_t value = 0;
+        for (size_t i = depth; i < length; ++i)
+        {
+            value |= uint64_t(str[i]) << (56 - 8 * (i - depth));
+        }
+        return value;
+    }
+
+    static inline void reloadKeys(Item *items, size_t count, size_t depth)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            items[i].key = loadKey(items[i].str, items[i].length, depth);
+        }
+    }
+
+    // Orders two items whose keys were loaded at depth.
+    static inline bool lessAt(const Item &a, const Item &b, size_t depth)
+    {
+        if (a.key != b.key)
+        {
+            return a.key < b.key;
+        }
+        if ((a.key & 0xFF) == 0)
+        {
+            return false;
+        }
+        size_t start = depth + 8;
+        size_t common = (a.length < b.length ? a.length : b.length);
+        if (common > start)
+        {
+            int result = std::memcmp(a.str + start, b.str + start, common - start);
+            if (result != 0)
+            {
+                return result < 0;
+            }
+        }
+        return a.length < b.length;
+    }
+
+    static inline void insertionSort(Item *items, size_t count, size_t depth)
+    {
+        for (size_t i = 1; i < count; ++i)
+        {
+            Item current = items[i];
+            size_t j = i;
+            while (j > 0 && lessAt(current, items[j - 1], depth))
+            {
+                items[j] = items[j - 1];
+                --j;
+            }
+            items[j] = current;
+        }
+    }
+
+    static inline uint64_t medianKey(const Item *items, size_t count)
+    {
+        uint64_t a = items[0].key;
+        uint64_t b = items[count / 2].key;
+        uint64_t c = items[count - 1].key;
+        if (a < b)
+        {
+            return b < c ? b : (a < c ? c : a);
+        }
+        return a < c ? a : (b < c ? c : b);
+    }
+
+    // Three-way radix quicksort on the cached keys; items must hold keys loaded at depth.
+    static void multikeyQuicksort(Item *items, size_t count, size_t depth)
+    {
+        while (count > insertionThreshold)
+        {
+            uint64_t pivot = medianKey(items, count);
+            size_t lt = 0;
+            size_t i = 0;
+            size_t gt = count;
+            while (i < gt)
+            {
+                if (items[i].key < pivot)
+                {
+                    std::swap(items[lt++], items[i++]);
+                }
+                else if (items[i].key > pivot)
+                {
+                    std::swap(items[i], items[--gt]);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+            multikeyQuicksort(items, lt, depth);
+            multikeyQuicksort(items + gt, count - gt, depth);
+
+            // A zero low byte means every string in the equal range ended inside this key.
+            if ((pivot & 0xFF) == 0)
+            {
+                return;
+            }
+            items += lt;
+            count = gt - lt;
+            depth += 8;
+            reloadKeys(items, count, depth);
+        }
+        insertionSort(items, count, depth);
+    }
+
+    // Distributes the items by the top byte of their keys and shifts that byte out.
+    // Bytes shared by all items are skipped in one step without moving anything.
+    // Returns false when all items ended, otherwise counts holds the bucket sizes.
+    static bool radixPass(Item *items, Item *scratch, size_t count, size_t &depth, size_t &remaining,
+                          size_t (&counts)[256])
+    {
+        for (;;)
+        {
+            if (remaining == 0)
+            {
+                reloadKeys(items, count, depth);
+                remaining = 8;
+            }
+            std::fill(std::begin(counts), std::end(counts), 0);
+            uint64_t first = items[0].key;
+            uint64_t diff = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                ++counts[items[i].key >> 56];
+                diff |= items[i].key ^ first;
+            }
+            size_t shared = static_cast<size_t>(std::countl_zero(diff)) / 8;
+            if (shared > remaining)
+            {
+                shared = remaining;
+            }
+            if (shared == 0)
+            {
+                break;
+            }
+            for (size_t k = 0; k < shared; ++k)
+            {
+                if (((first >> (56 - 8 * k)) & 0xFF) == 0)
+                {
+                    return false;
+                }
+            }
+            for (size_t i = 0; i < count; ++i)
+            {
+                items[i].key = (shared == 8) ? 0 : (items[i].key << (8 * shared));
+            }
+            depth += shared;
+            remaining -= shared;
+        }
+
+        size_t offsets[256];
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; ++b)
+        {
+            offsets[b] = offset;
+            offset += counts[b];
+        }
+        for (size_t i = 0; i < count; ++i)
+        {
+            Item &item = items[i];
+            Item &target = scratch[offsets[item.key >> 56]++];
+            target = item;
+            target.key <<= 8;
+        }
+        std::memcpy(static_cast<void *>(items), scratch, count * sizeof(Item));
+        ++depth;
+        --remaining;
+        return true;
+    }
+
+    static void radixSort(Item *items, Item *scratch, size_t count, size_t depth, size_t remaining)
+    {
+        if (count < quicksortThreshold)
+        {
+            if (remaining != 8)
+            {
+                reloadKeys(items, count, depth);
+            }
+            multikeyQuicksort(items, count, depth);
+            return;
+        }
+        size_t counts[256];
+        if (!radixPass(items, scratch, count, depth, remaining, counts))
+        {
+            return;
+        }
+        // Bucket 0 holds the strings that ended at this depth; they are all equal.
+        size_t start = counts[0];
+        for (size_t b = 1; b < 256; ++b)
+        {
+            if (counts[b] > 1)
+            {
+                radixSort(items + start, scratch + start, counts[b], depth, remaining);
+            }
+            start += counts[b];
+        }
+    }
+
+    void sortItems(std::vector<Item> &items) const
+    {
+        size_t count = items.size();
+        if (count < 2)
+        {
+            return;
+        }
+        std::vector<Item> scratch(count < quicksortThreshold ? 0 : count);
+        unsigned threads = threadCount;
+        if (count < parallelThreshold || threads < 2)
+        {
+            radixSort(items.data(), scratch.data(), count, 0, 8);
+            return;
+        }
+
+        size_t depth = 0;
+        size_t remaining = 8;
+        size_t counts[256];
+        if (!radixPass(items.data(), scratch.data(), count, depth, remaining, counts))
+        {
+            return;
+        }
+
+        // Hand the buckets out largest first so one big bucket doesn't finish last.
+        std::vector<std::pair<size_t, size_t>> buckets;
+        size_t start = counts[0];
+        for (size_t b = 1; b < 256; ++b)
+        {
+            if (counts[b] > 1)
+            {
+                buckets.emplace_back(start, counts[b]);
+            }
+            start += counts[b];
+        }
+        std::sort(buckets.begin(), buckets.end(),
+                  [](const auto &a, const auto &b) { return a.second > b.second; });
+
+        std::atomic<size_t> next(0);
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < buckets.size(); i = next.fetch_add(1))
+            {
+                size_t offset = buckets[i].first;
+                radixSort(items.data() + offset, scratch.data() + offset, buckets[i].second, depth, remaining);
+            }
+        };
+        if (threads > buckets.size())
+        {
+            threads = static_cast<unsigned>(buckets.size());
+        }
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; ++t)
+        {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread &thread : pool)
+        {
+            thread.join();
+        }
+    }
+
+  public:
+    // A thread count of 0 uses every hardware thread.
+    inline TStringSorter(unsigned threads = 0) : threadCount(threads)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::thread::hardware_concurrency();
+        }
+        if (threadCount == 0)
+        {
+            threadCount = 1;
+        }
+    }
+
+    inline void sort(std::vector<TString> &strings) const
+    {
+        std::vector<Item> items(strings.size());
+        for (size_t i = 0; i < strings.size(); ++i)
+        {
+            const unsigned char *str = reinterpret_cast<const unsigned char *>(strings[i].c_str());
+            items[i] = {loadKey(str, strings[i].size(), 0), str, strings[i].size(), i};
+        }
+        sortItems(items);
+
+        std::vector<TString> sorted;
+        sorted.reserve(strings.size());
+        for (const Item &item : items)
+        {
+            sorted.push_back(std::move(strings[item.index]));
+        }
+        strings.swap(sorted);
+    }
+
+    inline void sort(TStringColumn &column) const
+    {
+        std::vector<Item> items(column.size());
+        for (size_t i = 0; i < column.size(); ++i)
+        {
+            TStringConst view = column[i];
+            const unsigned char *str = reinterpret_cast<const unsigned char *>(view.c_str());
+            items[i] = {loadKey(str, view.size(), 0), str, view.size(), i};
+        }
+        sortItems(items);
+
+        std::vector<size_t> order;
+        order.reserve(items.size());
+        for (const Item &item : items)
+        {
+            order.push_back(item.index);
+        }
+        column.reorder(order);
+    }
+};
+
+inline void tstring_sort(std::vector<TString> &strings, unsigned threads = 0)
+{
+    TStringSorter(threads).sort(strings);
+}
+
+inline void tstring_sort(TStringColumn &column, unsigned threads = 0)
+{
+    TStringSorter(threads).sort(column);
+}
+
+#endif // TSTRING_SORT_HPP
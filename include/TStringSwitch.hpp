@@ -0,0 +1,207 @@
+#ifndef TSTRING_SWITCH_HPP
+#define TSTRING_SWITCH_HPP
+
+#include "TString.hpp"
+#include "TStringHash.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// A perfect hash over a fixed set of keywords, built at compile time:
+//
+//     static constexpr TStringSwitch commands({"get", "set", "delete"});
+//     switch (commands.lookup(input)) { case 0: ... }
+//
+// The keys are split into buckets by their hash, and each bucket gets a
+// displacement that sends all of its keys to distinct free slots (hash and
+// displace). lookup() hashes once, reads one displacement and one slot, and
+// confirms the hit with a length-checked compare. It returns the index of the
+// key in the original list, or npos.
+template <size_t N> class TStringSwitch
+{
+    static_assert(N > 0, "TStringSwitch needs at least one key");
+
+  public:
+    static constexpr size_t npos = std::string::npos;
+
+  private:
+    static constexpr size_t tableSize = std::bit_ceil(2 * N);
+    static constexpr size_t bucketCount = std::bit_ceil((N + 1) / 2);
+    static constexpr uint32_t emptySlot = UINT32_MAX;
+    static constexpr uint32_t maxDisplacement = 4 * tableSize;
+    static constexpr uint64_t maxSeed = 4096;
+
+    TStringConst keys[N];
+    uint64_t seed = 0;
+    uint32_t displacements[bucketCount] = {};
+    uint32_t table[tableSize] = {};
+
+    static constexpr size_t bucketOf(uint64_t hash)
+    {
+        return static_cast<size_t>(hash >> 40) & (bucketCount - 1);
+    }
+
+    static constexpr size_t slotOf(uint64_t hash, uint32_t displacement)
+    {
+        uint32_t base = static_cast<uint32_t>(hash);
+        uint32_t step = static_cast<uint32_t>(hash >> 20) | 1;
+        return static_cast<size_t>(base + displacement * step) & (tableSize - 1);
+    }
+
+    static constexpr bool sameKey(const TStringConst &a, const TStringConst &b)
+    {
+        return a.size() == b.size() && std::char_traits<char>::compare(a.c_str(), b.c_str(), a.size()) == 0;
+    }
+
+    constexpr bool tryBuild(uint64_t candidate)
+    {
+        uint64_t hashes[N] = {};
+        size_t bucketSizes[bucketCount] = {};
+        for (size_t i = 0; i < N; ++i)
+        {
+            hashes[i] = TStringHash::hash(keys[i].c_str(), keys[i].size(), candidate);
+            ++bucketSizes[bucketOf(hashes[i])];
+        }
+        for (size_t i = 0; i < tableSize; ++i)
+        {
+            table[i] = emptySlot;
+        }
+
+        // Place the largest buckets first while the table is still empty.
+        bool placed[bucketCount] = {};
+        for (size_t round = 0; round < bucketCount; ++round)
+        {
+            size_t bucket = bucketCount;
+            for (size_t b = 0; b < bucketCount; ++b)
+            {
+                if (!placed[b] && (bucket == bucketCount || bucketSizes[b] > bucketSizes[bucket]))
+                {
+                    bucket = b;
+                }
+            }
+            placed[bucket] = true;
+            displacements[bucket] = 0;
+            if (bucketSizes[bucket] == 0)
+            {
+                continue;
+            }
+
+            bool found = false;
+            for (uint32_t displacement = 0; displacement < maxDisplacement && !found; ++displacement)
+            {
+                size_t slots[N] = {};
+                size_t used = 0;
+                found = true;
+                for (size_t i = 0; i < N && found; ++i)
+                {
+                    if (bucketOf(hashes[i]) != bucket)
+                    {
+                        continue;
+                    }
+                    size_t slot = slotOf(hashes[i], displacement);
+                    found = table[slot] == emptySlot;
+                    for (size_t j = 0; j < used && found; ++j)
+                    {
+                        found = slots[j] != slot;
+                    }
+                    slots[used++] = slot;
+                }
+                if (found)
+                {
+                    displacements[bucket] = displacement;
+                    for (size_t i = 0; i < N; ++i)
+                    {
+                        if (bucketOf(hashes[i]) == bucket)
+                        {
+                            table[slotOf(hashes[i], displacement)] = static_cast<uint32_t>(i);
+                        }
+                    }
+                }
+            }
+            if (!found)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+  public:
+    consteval TStringSwitch(const TStringConst (&list)[N])
+    {
+        for (size_t i = 0; i < N; ++i)
+        {
+            keys[i] = list[i];
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (sameKey(keys[i], keys[j]))
+                {
+                    throw std::invalid_argument("Duplicate key in TStringSwitch");
+                }
+            }
+        }
+        for (uint64_t candidate = 0; candidate < maxSeed; ++candidate)
+        {
+            if (tryBuild(candidate))
+            {
+                seed = candidate;
+                return;
+            }
+        }
+        throw std::logic_error("No perfect hash found for TStringSwitch keys");
+    }
+
+    constexpr size_t lookup(const char *str, size_t len) const
+    {
+        uint64_t hash = TStringHash::hash(str, len, seed);
+        uint32_t index = table[slotOf(hash, displacements[bucketOf(hash)])];
+        if (index != emptySlot && keys[index].size() == len &&
+            std::char_traits<char>::compare(keys[index].c_str(), str, len) == 0)
+        {
+            return index;
+        }
+        return npos;
+    }
+
+    constexpr size_t lookup(const char *str) const
+    {
+        return lookup(TStringConst(str));
+    }
+
+    constexpr size_t lookup(const TStringConst &str) const
+    {
+        return lookup(str.c_str(), str.size());
+    }
+
+    constexpr size_t lookup(std::string_view str) const
+    {
+        return lookup(str.data(), str.size());
+    }
+
+    inline size_t lookup(const TString &str) const
+    {
+        return lookup(str.c_str(), str.size());
+    }
+
+    inline size_t lookup(const std::string &str) const
+    {
+        return lookup(str.data(), str.size());
+    }
+
+    constexpr size_t size() const
+    {
+        return N;
+    }
+
+    constexpr TStringConst key(size_t index) const
+    {
+        return keys[index];
+    }
+};
+
+template <size_t N> TStringSwitch(const TStringConst (&)[N]) -> TStringSwitch<N>;
+
+#endif // TSTRING_SWITCH_HPP
@@ -0,0 +1,312 @@
+#ifndef TSTRING_TOKENIZER_HPP
+#define TSTRING_TOKENIZER_HPP
+
+#include "TString.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+// Splits a stream that arrives in chunks into tokens, without buffering the
+// whole message. feed() hands over the next chunk and iterating the tokenizer
+// yields every token that is complete so far; finish() marks the end of the
+// stream and releases the last token. Like TString::split, empty tokens are
+// skipped.
+//
+//     TStringTokenizer tokens(',');
+//     while (read(socket, chunk))
+//     {
+//         tokens.feed(chunk);
+//         for (TStringConst token : tokens) { ... }
+//     }
+//     tokens.finish();
+//     for (TStringConst token : tokens) { ... }
+//
+// Tokens are views. A token that lies inside one chunk points into that
+// chunk, so a chunk has to stay alive until its tokens are consumed. A token
+// that spans chunks is collected in a carry buffer, which is reused and only
+// ever as large as the longest such token; the view is valid until the next
+// token is requested. The scanning loop is a coroutine that suspends when it
+// yields a token and when it runs out of input, so the tokenizer refers to
+// itself and can't be copied or moved.
+class TStringTokenizer
+{
+  private:
+    struct Routine
+    {
+        struct promise_type
+        {
+            TStringConst token;
+            bool yielded = false;
+            std::exception_ptr error;
+
+            Routine get_return_object()
+            {
+                return Routine{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always yield_value(TStringConst value) noexcept
+            {
+                token = value;
+                yielded = true;
+                return {};
+            }
+
+            void return_void() noexcept
+            {
+            }
+
+            void unhandled_exception() noexcept
+            {
+                error = std::current_exception();
+            }
+        };
+
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    Routine routine;
+    std::string_view chunk;
+    TString carry;
+    size_t maxCarry;
+    // The routine is suspended waiting for feed() or finish()
+    bool waiting = false;
+    bool finished = false;
+    char delimiter = '\0';
+    bool singleDelimiter = true;
+    bool isDelimiter[256] = {};
+
+    inline const char *findDelimiter(const char *cursor, const char *end) const
+    {
+        if (singleDelimiter)
+        {
+            const void *found = std::memchr(cursor, delimiter, static_cast<size_t>(end - cursor));
+            return found ? static_cast<const char *>(found) : end;
+        }
+        while (cursor < end && !isDelimiter[static_cast<unsigned char>(*cursor)])
+        {
+            ++cursor;
+        }
+        return cursor;
+    }
+
+    inline void appendCarry(const char *str, size_t len)
+    {
+        if (len > maxCarry - carry.size())
+        {
+            throw std::length_error("Token spanning chunks is longer than the tokenizer limit");
+        }
+        carry.append(str, len);
+    }
+
+    inline Routine scan()
+    {
+        for (;;)
+        {
+            waiting = true;
+            co_await std::suspend_always{};
+            if (finished)
+            {
+                break;
+            }
+            const char *cursor = chunk.data();
+            const char *end = cursor + chunk.size();
+            while (cursor < end)
+            {
+                const char *stop = findDelimiter(cursor, end);
+                if (stop == end)
+                {
+                    appendCarry(cursor, static_cast<size_t>(end - cursor));
+                    break;
+                }
+                if (carry.empty())
+                {
+                    if (stop > cursor)
+                    {
+                        co_yield TStringConst(cursor, static_cast<size_t>(stop - cursor));
+                    }
+                }
+                else
+                {
+                    appendCarry(cursor, static_cast<size_t>(stop - cursor));
+                    co_yield TStringConst(carry.c_str(), carry.size());
+                    carry.clear();
+                }
+                cursor = stop + 1;
+            }
+        }
+        if (!carry.empty())
+        {
+            co_yield TStringConst(carry.c_str(), carry.size());
+            carry.clear();
+        }
+    }
+
+    inline void start()
+    {
+        routine = scan();
+        routine.handle.resume();
+    }
+
+  public:
+    // maxCarry limits the length of a token that spans chunks; a longer one throws std::length_error
+    inline explicit TStringTokenizer(char delimiter, size_t maxCarry = SIZE_MAX)
+        : maxCarry(maxCarry), delimiter(delimiter)
+    {
+        start();
+    }
+
+    // Every character of delimiters separates tokens
+    inline explicit TStringTokenizer(const TStringConst &delimiters, size_t maxCarry = SIZE_MAX)
+        : maxCarry(maxCarry), singleDelimiter(delimiters.size() == 1)
+    {
+        delimiter = delimiters.empty() ? '\0' : delimiters[0];
+        for (size_t i = 0; i < delimiters.size(); ++i)
+        {
+            isDelimiter[static_cast<unsigned char>(delimiters[i])] = true;
+        }
+        start();
+    }
+
+    TStringTokenizer(const TStringTokenizer &) = delete;
+    TStringTokenizer &operator=(const TStringTokenizer &) = delete;
+
+    inline ~TStringTokenizer()
+    {
+        routine.handle.destroy();
+    }
+
+    // Hands over the next chunk. The tokens of the previous chunk must have been consumed.
+    inline void feed(std::string_view data)
+    {
+        if (!waiting || finished)
+        {
+            throw std::logic_error("TStringTokenizer fed before its tokens were consumed or after finish");
+        }
+        chunk = data;
+        waiting = false;
+    }
+
+    // Marks the end of the stream, so the last token no longer waits for a delimiter
+    inline void finish()
+    {
+        if (!waiting || finished)
+        {
+            throw std::logic_error("TStringTokenizer finished before its tokens were consumed or twice");
+        }
+        finished = true;
+        waiting = false;
+    }
+
+    // Stores the next complete token; false when the tokenizer needs more input or the stream has ended
+    inline bool next(TStringConst &token)
+    {
+        if (waiting || routine.handle.done())
+        {
+            return false;
+        }
+        routine.handle.resume();
+        Routine::promise_type &promise = routine.handle.promise();
+        if (promise.error)
+        {
+            // The routine has finished; reset() starts over
+            std::exception_ptr error = promise.error;
+            promise.error = nullptr;
+            std::rethrow_exception(error);
+        }
+        if (!promise.yielded)
+        {
+            return false;
+        }
+        promise.yielded = false;
+        token = promise.token;
+        return true;
+    }
+
+    // Whether finish() was called and every token has been consumed
+    inline bool done() const
+    {
+        return routine.handle.done();
+    }
+
+    // Starts a new stream; the carry buffer keeps its capacity
+    inline void reset()
+    {
+        routine.handle.destroy();
+        carry.clear();
+        chunk = {};
+        finished = false;
+        start();
+    }
+
+    class iterator
+    {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = TStringConst;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        inline explicit iterator(TStringTokenizer *tokenizer) : tokenizer(tokenizer)
+        {
+            ++*this;
+        }
+
+        inline const TStringConst &operator*() const
+        {
+            return token;
+        }
+
+        inline iterator &operator++()
+        {
+            if (!tokenizer->next(token))
+            {
+                tokenizer = nullptr;
+            }
+            return *this;
+        }
+
+        inline void operator++(int)
+        {
+            ++*this;
+        }
+
+        inline bool operator==(std::default_sentinel_t) const
+        {
+            return tokenizer == nullptr;
+        }
+
+      private:
+        TStringTokenizer *tokenizer = nullptr;
+        TStringConst token;
+    };
+
+    // Iterates over the tokens that are complete with the input so far
+    inline iterator begin()
+    {
+        return iterator(this);
+    }
+
+    inline std::default_sentinel_t end() const
+    {
+        return std::default_sentinel;
+    }
+};
+
+#endif // TSTRING_TOKENIZER_HPP
@@ -0,0 +1,158 @@
+#include "TString.hpp"
+#include "TStringArchive.hpp"
+
+#include "harness.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Startup cost of a large string dictionary: reading it back from a text file
+// with one string per line, against a TStringArchive of the same strings. The
+// files are written once to the temporary directory and read from the page
+// cache, so the cases measure parsing and allocation rather than the disk.
+
+namespace
+{
+const char *const dictionaryStems[] = {"account", "billing", "customer", "delivery", "inventory", "order",
+                                       "payment", "product", "session", "shipment", "user", "warehouse"};
+
+// Identifier-like words of 4 to about 40 bytes
+std::vector<TString> generateDictionary(size_t count)
+{
+    std::mt19937_64 rng(23);
+    std::vector<TString> words;
+    words.reserve(count);
+    std::string word;
+    for (size_t i = 0; i < count; ++i)
+    {
+        word = dictionaryStems[rng() % 12];
+        for (size_t parts = rng() % 3; parts > 0; --parts)
+        {
+            word += '_';
+            word += dictionaryStems[rng() % 12];
+        }
+        word += '_';
+        word += std::to_string(rng() % 1000000);
+        words.push_back(TString(word.data(), rng() % 8 == 0 ? 4 : word.size()));
+    }
+    return words;
+}
+
+std::vector<TString> readLines(const std::string &path)
+{
+    std::vector<TString> words;
+    std::ifstream in(path);
+    std::string line;
+    while (std::getline(in, line))
+    {
+        words.push_back(TString(line));
+    }
+    return words;
+}
+
+// Reads the whole file, then splits it at newlines
+std::vector<TString> readBulk(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    std::string text(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(text.data(), static_cast<std::streamsize>(text.size()));
+    std::vector<TString> words;
+    const char *cursor = text.data();
+    const char *end = text.data() + text.size();
+    while (cursor < end)
+    {
+        const char *newline = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+        const char *stop = newline ? newline : end;
+        words.push_back(TString(cursor, stop - cursor));
+        cursor = stop + 1;
+    }
+    return words;
+}
+
+// Time per load and per string, with the speed-up over reading the text file line by line
+void printStartup(BenchmarkHarness &harness, const std::string &group, size_t count, uintmax_t textBytes,
+                  uintmax_t archiveBytes)
+{
+    std::cout << "\n"
+              << std::left << std::setw(44) << "Dictionary load" << std::right << std::setw(14) << "ms per load"
+              << std::setw(14) << "ns/string" << std::setw(14) << "Speed-up" << "\n";
+    std::cout << std::string(86, '-') << "\n";
+    double reference = 0;
+    for (const BenchmarkResult &result : harness.results())
+    {
+        if (result.group != group)
+        {
+            continue;
+        }
+        if (reference == 0)
+        {
+            reference = result.stats.median;
+        }
+        std::cout << std::left << std::setw(44) << result.variant << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << result.stats.median * static_cast<double>(count) / 1e6 << std::setw(14)
+                  << result.stats.median << std::setw(13) << reference / result.stats.median << "x" << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << count << " strings, text file " << textBytes / 1000000 << " MB, archive " << archiveBytes / 1000000
+              << " MB\n";
+}
+} // namespace
+
+void runArchiveBenchmarks(BenchmarkHarness &harness)
+{
+    const std::string group = "Startup";
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    // 10 M strings at the default --elements
+    const size_t count = harness.options().elements * 10;
+    harness.section(group + " (ns per string)");
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    const std::string textPath = (directory / "tstring_benchmark_dictionary.txt").string();
+    const std::string archivePath = (directory / "tstring_benchmark_dictionary.tsa").string();
+    {
+        std::vector<TString> words = generateDictionary(count);
+        std::ofstream text(textPath, std::ios::binary);
+        for (const TString &word : words)
+        {
+            text.write(word.c_str(), static_cast<std::streamsize>(word.size()));
+            text.put('\n');
+        }
+        tstring_save(archivePath, words);
+    }
+
+    std::vector<TString> loaded;
+    auto release = [&] { loaded = std::vector<TString>(); };
+    harness.runBatch(group, "text getline", 0, count, release, [&] { loaded = readLines(textPath); });
+    harness.runBatch(group, "text bulk read", 0, count, release, [&] { loaded = readBulk(textPath); });
+    harness.runBatch(group, "archive tstring_load", 0, count, release, [&] { loaded = tstring_load(archivePath); });
+    release();
+
+    // Views into the mapping: the cost no longer depends on the number of strings, unless verified
+    TStringArchive archive;
+    harness.runBatch(
+        group, "archive map", 0, count, [&] { archive = TStringArchive(); },
+        [&] { archive = TStringArchive(archivePath, false); });
+    harness.runBatch(
+        group, "archive map verified", 0, count, [&] { archive = TStringArchive(); },
+        [&] { archive = TStringArchive(archivePath, true); });
+    if (archive.size() != count)
+    {
+        std::cerr << "Archive holds " << archive.size() << " strings instead of " << count << std::endl;
+    }
+    archive = TStringArchive();
+
+    printStartup(harness, group, count, std::filesystem::file_size(textPath), std::filesystem::file_size(archivePath));
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(archivePath);
+}
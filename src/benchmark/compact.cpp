@@ -0,0 +1,64 @@
+#include "TStringCompact.hpp"
+
+#include "data.hpp"
+#include "harness.hpp"
+
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Compares random pairs out of a large key set so that most accesses miss the cache
+void runCompactBenchmarks(BenchmarkHarness &harness)
+{
+    if (!harness.enabled("Compare"))
+    {
+        return;
+    }
+    harness.section("Compare (cold)");
+
+    std::vector<std::string> keys = generateRandomKeys(2 * harness.options().elements);
+    std::vector<TString> strings(keys.begin(), keys.end());
+    std::vector<TStringCompact> compacts(strings.begin(), strings.end());
+
+    std::mt19937_64 rng(99);
+    std::vector<uint32_t> pairs(size_t(1) << 22);
+    for (uint32_t &index : pairs)
+    {
+        index = static_cast<uint32_t>(rng() % strings.size());
+    }
+    const size_t mask = pairs.size() / 2 - 1;
+
+    auto pairwise = [&](const auto &values, auto op) {
+        return [&values, &pairs, mask, op](size_t iterations) {
+            size_t count = 0;
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                size_t pair = 2 * (i & mask);
+                count += op(values[pairs[pair]], values[pairs[pair + 1]]);
+            }
+            doNotOptimize(count);
+        };
+    };
+    auto less = [](const auto &a, const auto &b) { return a < b; };
+    auto equal = [](const auto &a, const auto &b) { return a == b; };
+
+    harness.run("Compare Less", "TString", 0, pairwise(strings, less));
+    harness.run("Compare Less", "TStringCompact", 0, pairwise(compacts, less));
+    harness.run("Compare Equal", "TString", 0, pairwise(strings, equal));
+    harness.run("Compare Equal", "TStringCompact", 0, pairwise(compacts, equal));
+
+    for (size_t i = 0; i + 1 < pairs.size(); i += 2)
+    {
+        const TString &a = strings[pairs[i]];
+        const TString &b = strings[pairs[i + 1]];
+        const TStringCompact &ca = compacts[pairs[i]];
+        const TStringCompact &cb = compacts[pairs[i + 1]];
+        if ((a < b) != (ca < cb) || (a == b) != (ca == cb))
+        {
+            std::cerr << "TStringCompact comparison results differ from TString" << std::endl;
+            break;
+        }
+    }
+}
@@ -0,0 +1,425 @@
+#include "harness.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+// Baseline comparison for --compare: reads a file written by --export and
+// tests every case that exists in both runs.
+//
+// The samples of a case are compared with a two-sided Mann-Whitney U test,
+// which makes no assumption about the shape of the timing distribution. The
+// change is the Hodges-Lehmann estimate of the shift between the log samples,
+// with its distribution-free confidence interval, reported as a percentage.
+
+namespace
+{
+struct JsonValue
+{
+    enum class Kind
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    const JsonValue *get(const std::string &key) const
+    {
+        auto it = object.find(key);
+        return it == object.end() ? nullptr : &it->second;
+    }
+};
+
+// Just enough JSON for the documents this benchmark writes
+class JsonParser
+{
+  public:
+    explicit JsonParser(const std::string &text) : text(text)
+    {
+    }
+
+    bool parse(JsonValue &value)
+    {
+        if (!parseValue(value))
+        {
+            return false;
+        }
+        skipSpace();
+        return pos == text.size();
+    }
+
+  private:
+    const std::string &text;
+    size_t pos = 0;
+
+    void skipSpace()
+    {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos])))
+        {
+            ++pos;
+        }
+    }
+
+    bool consume(char ch)
+    {
+        skipSpace();
+        if (pos < text.size() && text[pos] == ch)
+        {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    bool parseString(std::string &out)
+    {
+        if (!consume('"'))
+        {
+            return false;
+        }
+        while (pos < text.size() && text[pos] != '"')
+        {
+            char ch = text[pos++];
+            if (ch == '\\' && pos < text.size())
+            {
+                char escaped = text[pos++];
+                if (escaped == 'u' && pos + 4 <= text.size())
+                {
+                    out += static_cast<char>(std::strtol(text.substr(pos, 4).c_str(), nullptr, 16));
+                    pos += 4;
+                    continue;
+                }
+                ch = escaped == 'n' ? '\n' : escaped == 't' ? '\t' : escaped;
+            }
+            out += ch;
+        }
+        return consume('"');
+    }
+
+    bool parseValue(JsonValue &value)
+    {
+        skipSpace();
+        if (pos >= text.size())
+        {
+            return false;
+        }
+        char ch = text[pos];
+        if (ch == '{')
+        {
+            ++pos;
+            value.kind = JsonValue::Kind::Object;
+            if (consume('}'))
+            {
+                return true;
+            }
+            do
+            {
+                std::string key;
+                if (!parseString(key) || !consume(':') || !parseValue(value.object[key]))
+                {
+                    return false;
+                }
+            } while (consume(','));
+            return consume('}');
+        }
+        if (ch == '[')
+        {
+            ++pos;
+            value.kind = JsonValue::Kind::Array;
+            if (consume(']'))
+            {
+                return true;
+            }
+            do
+            {
+                value.array.emplace_back();
+                if (!parseValue(value.array.back()))
+                {
+                    return false;
+                }
+            } while (consume(','));
+            return consume(']');
+        }
+        if (ch == '"')
+        {
+            value.kind = JsonValue::Kind::String;
+            return parseString(value.string);
+        }
+        if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0)
+        {
+            value.kind = JsonValue::Kind::Boolean;
+            value.boolean = text[pos] == 't';
+            pos += value.boolean ? 4 : 5;
+            return true;
+        }
+        if (text.compare(pos, 4, "null") == 0)
+        {
+            pos += 4;
+            return true;
+        }
+        char *end = nullptr;
+        value.kind = JsonValue::Kind::Number;
+        value.number = std::strtod(text.c_str() + pos, &end);
+        if (end == text.c_str() + pos)
+        {
+            return false;
+        }
+        pos = static_cast<size_t>(end - text.c_str());
+        return true;
+    }
+};
+
+struct Comparison
+{
+    double pValue = 1;
+    // Relative change of the new run against the baseline, in percent
+    double change = 0;
+    double lower = 0;
+    double upper = 0;
+};
+
+double normalQuantile(double p)
+{
+    // Acklam's rational approximation, accurate to about 1e-9
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01,  -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    if (p < 0.02425)
+    {
+        double q = std::sqrt(-2 * std::log(p));
+        return (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+               ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+    }
+    if (p > 1 - 0.02425)
+    {
+        return -normalQuantile(1 - p);
+    }
+    double q = p - 0.5;
+    double r = q * q;
+    return (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+           (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1);
+}
+
+Comparison compareSamples(const std::vector<double> &baseline, const std::vector<double> &current, double alpha)
+{
+    Comparison result;
+    size_t m = baseline.size();
+    size_t n = current.size();
+    if (m == 0 || n == 0)
+    {
+        return result;
+    }
+
+    // Mann-Whitney U with average ranks for ties and the tie-corrected normal approximation
+    std::vector<std::pair<double, bool>> pooled;
+    for (double sample : baseline)
+    {
+        pooled.emplace_back(sample, false);
+    }
+    for (double sample : current)
+    {
+        pooled.emplace_back(sample, true);
+    }
+    std::sort(pooled.begin(), pooled.end());
+    double rankSum = 0;
+    double tieTerm = 0;
+    for (size_t i = 0; i < pooled.size();)
+    {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first)
+        {
+            ++j;
+        }
+        double rank = (static_cast<double>(i + j) + 1) / 2;
+        for (size_t k = i; k < j; ++k)
+        {
+            rankSum += pooled[k].second ? rank : 0;
+        }
+        double ties = static_cast<double>(j - i);
+        tieTerm += ties * ties * ties - ties;
+        i = j;
+    }
+    double total = static_cast<double>(m + n);
+    double u = rankSum - static_cast<double>(n) * (static_cast<double>(n) + 1) / 2;
+    double mean = static_cast<double>(m) * static_cast<double>(n) / 2;
+    double variance =
+        static_cast<double>(m) * static_cast<double>(n) / 12 * ((total + 1) - tieTerm / (total * (total - 1)));
+    if (variance > 0)
+    {
+        double z = (std::fabs(u - mean) - 0.5) / std::sqrt(variance);
+        result.pValue = std::min(1.0, std::erfc(std::max(z, 0.0) / std::sqrt(2.0)));
+    }
+
+    // Hodges-Lehmann shift of the log samples and its confidence interval
+    std::vector<double> differences;
+    differences.reserve(m * n);
+    for (double now : current)
+    {
+        for (double before : baseline)
+        {
+            differences.push_back(std::log(now) - std::log(before));
+        }
+    }
+    std::sort(differences.begin(), differences.end());
+    size_t count = differences.size();
+    double median = count % 2 ? differences[count / 2] : (differences[count / 2 - 1] + differences[count / 2]) / 2;
+    double z = normalQuantile(1 - alpha / 2);
+    double k = std::floor(mean - z * std::sqrt(static_cast<double>(m * n) * (total + 1) / 12));
+    size_t lowerIndex = k >= 1 ? static_cast<size_t>(k) - 1 : 0;
+    size_t upperIndex = count - 1 - lowerIndex;
+    result.change = 100 * std::expm1(median);
+    result.lower = 100 * std::expm1(differences[std::min(lowerIndex, count - 1)]);
+    result.upper = 100 * std::expm1(differences[std::max(upperIndex, lowerIndex)]);
+    return result;
+}
+
+std::string formatPercent(double value)
+{
+    std::ostringstream out;
+    out << std::showpos << std::fixed << std::setprecision(1) << value << "%";
+    return out.str();
+}
+} // namespace
+
+int compareWithBaseline(const BenchmarkHarness &harness, const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in.is_open())
+    {
+        std::cerr << "Failed to open baseline " << path << std::endl;
+        return -1;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    JsonValue document;
+    const JsonValue *schema = nullptr;
+    const JsonValue *version = nullptr;
+    const JsonValue *results = nullptr;
+    if (JsonParser(text).parse(document))
+    {
+        schema = document.get("schema");
+        version = document.get("schema_version");
+        results = document.get("results");
+    }
+    if (schema == nullptr || schema->string != "tstring-benchmark" || version == nullptr || results == nullptr)
+    {
+        std::cerr << "Baseline " << path << " is not a BenchMark --export file" << std::endl;
+        return -1;
+    }
+    if (static_cast<int>(version->number) != benchmarkSchemaVersion)
+    {
+        std::cerr << "Baseline schema version " << version->number << " does not match " << benchmarkSchemaVersion
+                  << "; re-export the baseline with this build" << std::endl;
+        return -1;
+    }
+
+    // Instrumentation adds work to every allocation, so such timings are not comparable with plain ones
+#ifdef TSTRING_INSTRUMENT
+    const bool instrumented = true;
+#else
+    const bool instrumented = false;
+#endif
+    const BenchmarkOptions &options = harness.options();
+    const JsonValue *environment = document.get("environment");
+    const JsonValue *baselineInstrumented = environment ? environment->get("instrumented") : nullptr;
+    const JsonValue *baselineMinTime = environment ? environment->get("min_repetition_ns") : nullptr;
+    if (baselineInstrumented == nullptr || baselineInstrumented->boolean != instrumented)
+    {
+        std::cerr << "Baseline " << path << (instrumented ? " is not" : " is")
+                  << " an instrumented build and this run is" << (instrumented ? "" : " not")
+                  << "; record both with the same build" << std::endl;
+        return -1;
+    }
+    if (baselineMinTime == nullptr ||
+        static_cast<long long>(baselineMinTime->number) != static_cast<long long>(options.minRepetitionTime.count()))
+    {
+        std::cerr << "Warning: baseline repetitions ran for at least "
+                  << static_cast<long long>(baselineMinTime ? baselineMinTime->number : 0) << " ns and this run's for "
+                  << options.minRepetitionTime.count()
+                  << " ns; timings may not be comparable" << std::endl;
+    }
+
+    std::map<std::string, std::vector<double>> baseline;
+    for (const JsonValue &entry : results->array)
+    {
+        const JsonValue *name = entry.get("name");
+        const JsonValue *samples = entry.get("samples");
+        if (name == nullptr || samples == nullptr)
+        {
+            continue;
+        }
+        std::vector<double> &values = baseline[name->string];
+        for (const JsonValue &sample : samples->array)
+        {
+            values.push_back(sample.number);
+        }
+    }
+
+    std::cout << "\n"
+              << std::left << std::setw(52) << ("Comparison with " + path) << std::right << std::setw(12) << "Change"
+              << std::setw(24) << "Confidence interval" << std::setw(10) << "p" << "  Verdict\n";
+    std::cout << std::string(110, '-') << "\n";
+
+    int regressions = 0;
+    size_t matched = 0;
+    for (const BenchmarkResult &result : harness.results())
+    {
+        auto it = baseline.find(result.name());
+        if (it == baseline.end())
+        {
+            continue;
+        }
+        ++matched;
+        Comparison comparison = compareSamples(it->second, result.samples, options.significance);
+        bool significant = comparison.pValue < options.significance;
+        const char *verdict = "";
+        if (significant && comparison.change > options.regressionThreshold)
+        {
+            verdict = "REGRESSION";
+            ++regressions;
+        }
+        else if (significant && comparison.change < -options.regressionThreshold)
+        {
+            verdict = "improvement";
+        }
+        std::cout << std::left << std::setw(52) << result.name() << std::right << std::setw(12)
+                  << formatPercent(comparison.change) << std::setw(24)
+                  << ("[" + formatPercent(comparison.lower) + ", " + formatPercent(comparison.upper) + "]")
+                  << std::setw(10) << std::setprecision(3) << comparison.pValue << "  " << verdict << "\n";
+    }
+    std::cout << std::setprecision(6);
+
+    std::cout << matched << " cases compared, " << regressions << " significant regressions above "
+              << options.regressionThreshold << "% at alpha " << options.significance << "\n";
+    if (matched == 0)
+    {
+        // Nothing was compared, so the run must not pass as free of regressions
+        std::cerr << "No case in this run matches the baseline; check --filter, --max-size and the case names"
+                  << std::endl;
+        return -1;
+    }
+    return regressions;
+}
@@ -0,0 +1,173 @@
+#include "TString.hpp"
+
+#include "data.hpp"
+#include "harness.hpp"
+
+#include <string>
+
+namespace
+{
+const char *const baseCString = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+
+// Runs the same body once with TString and once with std::string
+template <typename Body> void compare(BenchmarkHarness &harness, const std::string &group, size_t size, Body body)
+{
+    harness.run(group, "TString", size, [&](size_t iterations) { body(TString(), iterations); });
+    harness.run(group, "std::string", size, [&](size_t iterations) { body(std::string(), iterations); });
+}
+
+void sweep(BenchmarkHarness &harness, const std::string &group, void (*run)(BenchmarkHarness &, const std::string &,
+                                                                           const std::string &, size_t))
+{
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group);
+    const std::string text = generateText(harness.options().maxSize);
+    for (size_t size : harness.sizes())
+    {
+        run(harness, group, text, size);
+    }
+}
+
+void construction(BenchmarkHarness &harness, const std::string &group, const std::string &text, size_t size)
+{
+    compare(harness, group, size, [&](auto tag, size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            decltype(tag) str(text.data(), size);
+            doNotOptimize(str);
+        }
+    });
+}
+
+void copy(BenchmarkHarness &harness, const std::string &group, const std::string &text, size_t size)
+{
+    compare(harness, group, size, [&](auto tag, size_t iterations) {
+        const decltype(tag) source(text.data(), size);
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            decltype(tag) str(source);
+            doNotOptimize(str);
+        }
+    });
+}
+
+// The needle sits in the last byte, so every find scans the whole string
+void find(BenchmarkHarness &harness, const std::string &group, const std::string &text, size_t size)
+{
+    std::string haystack = text.substr(0, size);
+    haystack.back() = 'z';
+    compare(harness, group, size, [&](auto tag, size_t iterations) {
+        const decltype(tag) source(haystack);
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            size_t pos = source.find("z");
+            doNotOptimize(pos);
+        }
+    });
+}
+
+void substring(BenchmarkHarness &harness, const std::string &group, const std::string &text, size_t size)
+{
+    compare(harness, group, size, [&](auto tag, size_t iterations) {
+        const decltype(tag) source(text.data(), size);
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            decltype(tag) str = source.substr(size / 4, size / 2);
+            doNotOptimize(str);
+        }
+    });
+}
+
+void equal(BenchmarkHarness &harness, const std::string &group, const std::string &text, size_t size)
+{
+    compare(harness, group, size, [&](auto tag, size_t iterations) {
+        const decltype(tag) left(text.data(), size);
+        const decltype(tag) right(text.data(), size);
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            bool same = left == right;
+            doNotOptimize(same);
+        }
+    });
+}
+} // namespace
+
+void runCoreBenchmarks(BenchmarkHarness &harness)
+{
+    sweep(harness, "Construction", construction);
+    sweep(harness, "Copy", copy);
+    sweep(harness, "Find", find);
+    sweep(harness, "Substring", substring);
+    sweep(harness, "Equal", equal);
+
+    if (harness.enabled("Append"))
+    {
+        harness.section("Append (+= \"a\")");
+        compare(harness, "Append", 0, [](auto tag, size_t iterations) {
+            decltype(tag) str(baseCString);
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                str += "a";
+            }
+            doNotOptimize(str);
+        });
+    }
+
+    if (harness.enabled("Append push_back"))
+    {
+        harness.section("Append (push_back)");
+        compare(harness, "Append push_back", 0, [](auto tag, size_t iterations) {
+            decltype(tag) str;
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                str.push_back(static_cast<char>('a' + i % 26));
+            }
+            doNotOptimize(str);
+        });
+    }
+
+    if (harness.enabled("Append chunk"))
+    {
+        harness.section("Append (16-byte chunk, pointer and length)");
+        compare(harness, "Append chunk", 0, [](auto tag, size_t iterations) {
+            decltype(tag) str;
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                str.append(baseCString + i % 32, 16);
+            }
+            doNotOptimize(str);
+        });
+    }
+
+    // Line building with chained operator+, where every step after the first is on a temporary
+    if (harness.enabled("Builder"))
+    {
+        harness.section("Builder (key=value lines)");
+        compare(harness, "Builder", 0, [](auto tag, size_t iterations) {
+            const decltype(tag) key("customer_id");
+            const decltype(tag) value("00000000042");
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                decltype(tag) line = key + "=" + value + "; path=/api/v1/orders" + "\n";
+                doNotOptimize(line);
+            }
+        });
+    }
+
+    if (harness.enabled("Clear"))
+    {
+        harness.section("Clear and reassign");
+        compare(harness, "Clear", 0, [](auto tag, size_t iterations) {
+            decltype(tag) str(baseCString);
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                str.clear();
+                str = baseCString;
+                doNotOptimize(str);
+            }
+        });
+    }
+}
@@ -0,0 +1,58 @@
+#ifndef TSTRING_BENCHMARK_DATA_HPP
+#define TSTRING_BENCHMARK_DATA_HPP
+
+#include <random>
+#include <string>
+#include <vector>
+
+// URL-like keys: few hosts and long shared path prefixes
+inline std::vector<std::string> generateUrlKeys(size_t count)
+{
+    const char *hosts[] = {"https://www.example.com/", "https://api.example.com/v2/",
+                           "https://cdn.example.org/assets/"};
+    const char *sections[] = {"products/", "users/", "search?q=", "static/images/", "orders/history/"};
+    std::mt19937_64 rng(42);
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string key = hosts[rng() % 3];
+        key += sections[rng() % 5];
+        key += std::to_string(rng() % 100000);
+        key += "/item-";
+        key += std::to_string(rng() % 1000);
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+// Random printable keys of 8 to 40 bytes
+inline std::vector<std::string> generateRandomKeys(size_t count)
+{
+    std::mt19937_64 rng(7);
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string key(8 + rng() % 33, ' ');
+        for (char &ch : key)
+        {
+            ch = static_cast<char>('!' + rng() % 94);
+        }
+        keys.push_back(std::move(key));
+    }
+    return keys;
+}
+
+// Lowercase text of the given size cycling through 'a' to 'y', so 'z' never occurs
+inline std::string generateText(size_t size)
+{
+    std::string text(size, ' ');
+    for (size_t i = 0; i < size; ++i)
+    {
+        text[i] = static_cast<char>('a' + i % 25);
+    }
+    return text;
+}
+
+#endif // TSTRING_BENCHMARK_DATA_HPP
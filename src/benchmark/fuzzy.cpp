@@ -0,0 +1,202 @@
+#include "TString.hpp"
+#include "TStringFuzzy.hpp"
+
+#include "harness.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Typo-tolerant lookup: the distance from a query to every product name of a
+// catalogue, and locating a misspelt needle in a long text. The reference is
+// the textbook dynamic program that fills a matrix allocated per call.
+
+namespace
+{
+const char *const words[] = {"wireless", "mouse", "keyboard", "monitor", "stand", "usb", "cable", "charger",
+                             "laptop",   "sleeve", "phone",   "case",    "black", "pro", "mini",  "ultra"};
+
+std::vector<TString> generateNames(size_t count, size_t minLength)
+{
+    std::mt19937_64 rng(37);
+    std::vector<TString> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string name = words[rng() % 16];
+        while (name.size() < minLength || rng() % 3 != 0)
+        {
+            name += ' ';
+            name += words[rng() % 16];
+        }
+        names.push_back(TString(name));
+    }
+    return names;
+}
+
+// Replaces, drops or inserts a few bytes
+TString misspell(const TString &str, size_t edits, std::mt19937_64 &rng)
+{
+    std::string typo(str.c_str(), str.size());
+    for (size_t e = 0; e < edits && !typo.empty(); ++e)
+    {
+        size_t pos = rng() % typo.size();
+        switch (rng() % 3)
+        {
+        case 0:
+            typo[pos] = static_cast<char>('a' + rng() % 26);
+            break;
+        case 1:
+            typo.erase(pos, 1);
+            break;
+        default:
+            typo.insert(pos, 1, static_cast<char>('a' + rng() % 26));
+            break;
+        }
+    }
+    return TString(typo);
+}
+
+size_t matrixDistance(const TString &a, const TString &b)
+{
+    size_t columns = b.size() + 1;
+    std::vector<size_t> matrix((a.size() + 1) * columns);
+    for (size_t j = 0; j < columns; ++j)
+    {
+        matrix[j] = j;
+    }
+    for (size_t i = 1; i <= a.size(); ++i)
+    {
+        matrix[i * columns] = i;
+        for (size_t j = 1; j < columns; ++j)
+        {
+            size_t substitute = matrix[(i - 1) * columns + j - 1] + (a[i - 1] != b[j - 1]);
+            size_t remove = matrix[(i - 1) * columns + j] + 1;
+            size_t insert = matrix[i * columns + j - 1] + 1;
+            matrix[i * columns + j] = std::min(substitute, std::min(remove, insert));
+        }
+    }
+    return matrix.back();
+}
+
+// Sellers' search: the same program with a free start row, one column at a time
+size_t matrixFind(const TString &needle, const TString &haystack, size_t maxDistance)
+{
+    std::vector<size_t> column(needle.size() + 1);
+    for (size_t i = 0; i <= needle.size(); ++i)
+    {
+        column[i] = i;
+    }
+    for (size_t j = 0; j < haystack.size(); ++j)
+    {
+        size_t diagonal = 0;
+        for (size_t i = 1; i <= needle.size(); ++i)
+        {
+            size_t above = column[i];
+            column[i] = std::min(diagonal + (needle[i - 1] != haystack[j]), std::min(above, column[i - 1]) + 1);
+            diagonal = above;
+        }
+        if (column.back() <= maxDistance)
+        {
+            return j + 1;
+        }
+    }
+    return TStringConst::npos;
+}
+
+void distanceCases(BenchmarkHarness &harness, const std::string &group, const std::string &suffix,
+                   const std::vector<TString> &names, const std::vector<TString> &queries)
+{
+    size_t pairs = names.size() * queries.size();
+    size_t matrixSum = 0;
+    size_t bitSum = 0;
+    harness.runBatch(group, "matrix DP" + suffix, 0, pairs, [] {}, [&] {
+        matrixSum = 0;
+        for (const TString &query : queries)
+        {
+            for (const TString &name : names)
+            {
+                matrixSum += matrixDistance(query, name);
+            }
+        }
+    });
+    harness.runBatch(group, "tstring_edit_distance" + suffix, 0, pairs, [] {}, [&] {
+        bitSum = 0;
+        for (const TString &query : queries)
+        {
+            for (const TString &name : names)
+            {
+                bitSum += tstring_edit_distance(query, name);
+            }
+        }
+    });
+    size_t hits = 0;
+    harness.runBatch(group, "TStringFuzzy filter k=2" + suffix, 0, pairs, [] {}, [&] {
+        hits = 0;
+        for (const TString &query : queries)
+        {
+            hits += TStringFuzzy(query, 2).filter(names).size();
+        }
+    });
+    doNotOptimize(hits);
+    if (matrixSum != bitSum)
+    {
+        std::cerr << "Edit distances disagree: " << matrixSum << " and " << bitSum << std::endl;
+    }
+}
+} // namespace
+
+void runFuzzyBenchmarks(BenchmarkHarness &harness)
+{
+    std::mt19937_64 rng(41);
+    const std::string group = "Edit distance";
+    if (harness.enabled(group))
+    {
+        harness.section(group + " (ns per pair)");
+        // Product names of 5 to about 40 bytes; blocked queries of 200 bytes and more
+        const std::vector<TString> names = generateNames(harness.options().elements / 100, 0);
+        std::vector<TString> queries;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            queries.push_back(misspell(names[rng() % names.size()], 2, rng));
+        }
+        distanceCases(harness, group, "", names, queries);
+
+        const std::vector<TString> descriptions = generateNames(100, 200);
+        std::vector<TString> longQueries;
+        for (size_t i = 0; i < 10; ++i)
+        {
+            longQueries.push_back(misspell(descriptions[rng() % descriptions.size()], 4, rng));
+        }
+        distanceCases(harness, group, " 200+ B", descriptions, longQueries);
+    }
+
+    const std::string findGroup = "Fuzzy find";
+    if (harness.enabled(findGroup))
+    {
+        harness.section(findGroup + " (ns per haystack byte)");
+        // A 1 MB text with a misspelt needle near the end
+        const TString needle("ultra wireless keyboard charger");
+        std::string text;
+        while (text.size() < (1 << 20))
+        {
+            text += words[rng() % 16];
+            text += ' ';
+        }
+        text += misspell(needle, 2, rng).c_str();
+        const TString haystack(text);
+        size_t matrixEnd = 0;
+        TStringFuzzyMatch found;
+        harness.runBatch(findGroup, "matrix DP", 0, haystack.size(), [] {},
+                         [&] { matrixEnd = matrixFind(needle, haystack, 2); });
+        const TStringFuzzy fuzzy(needle, 2);
+        harness.runBatch(findGroup, "TStringFuzzy::find", 0, haystack.size(), [] {},
+                         [&] { found = fuzzy.find(haystack); });
+        if (found.pos == TStringConst::npos || found.pos + found.length < matrixEnd)
+        {
+            std::cerr << "Fuzzy find missed the needle" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,213 @@
+#include "TString.hpp"
+
+#include "data.hpp"
+#include "harness.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+// TString growth policies on the same set of strings: the time to build the
+// strings, and the resident memory they occupy once built, including the
+// string objects themselves. Strings are built either at their final length
+// or by appending 8-byte chunks, which is where the growth factor matters.
+
+namespace
+{
+using PowerOfTwoString = TStringBasic<TStringGrowthPowerOfTwo>;
+using GeometricString = TStringBasic<TStringGrowthGeometric>;
+using ExactFitString = TStringBasic<TStringGrowthExactFit>;
+
+const size_t maxLength = 1024;
+const size_t chunk = 8;
+
+// Log-uniform lengths from 1 to maxLength bytes: mostly short strings, with a long tail
+std::vector<size_t> generateLengths(size_t count)
+{
+    std::mt19937_64 rng(17);
+    std::uniform_real_distribution<double> exponent(0, std::log2(static_cast<double>(maxLength)));
+    std::vector<size_t> lengths;
+    lengths.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        lengths.push_back(static_cast<size_t>(std::exp2(exponent(rng))));
+    }
+    return lengths;
+}
+
+// Resident set size of the process in bytes, 0 where it can't be read
+size_t residentBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return counters.WorkingSetSize;
+    }
+    return 0;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    size_t pages = 0;
+    size_t resident = 0;
+    statm >> pages >> resident;
+    return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+// Hands freed heap pages back to the system, so the next measurement starts from a clean baseline
+void releaseFreedMemory()
+{
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+template <typename T>
+void buildExact(std::vector<T> &strings, const std::string &text, const std::vector<size_t> &lengths)
+{
+    for (size_t length : lengths)
+    {
+        strings.push_back(T(text.data(), length));
+    }
+}
+
+template <typename T>
+void buildAppended(std::vector<T> &strings, const std::string &text, const std::vector<size_t> &lengths)
+{
+    for (size_t length : lengths)
+    {
+        T str;
+        for (size_t done = 0; done < length; done += chunk)
+        {
+            str.append(text.data() + done, length - done < chunk ? length - done : chunk);
+        }
+        strings.push_back(std::move(str));
+    }
+}
+
+struct MemoryResult
+{
+    std::string variant;
+    // Resident bytes per string, string object included; also MB per million strings
+    double bytesPerString = 0;
+};
+
+// Times building the strings, then builds them once more to measure the resident memory they hold
+template <typename T, typename Build>
+void measureVariant(BenchmarkHarness &harness, const std::string &group, const char *variant,
+                    const std::vector<size_t> &lengths, Build build, std::vector<MemoryResult> &memory)
+{
+    std::vector<T> strings;
+    harness.runBatch(
+        group, variant, 0, lengths.size(),
+        [&] {
+            strings = std::vector<T>();
+            strings.reserve(lengths.size());
+        },
+        [&] { build(strings); });
+    strings = std::vector<T>();
+
+    releaseFreedMemory();
+    size_t before = residentBytes();
+    strings.reserve(lengths.size());
+    build(strings);
+    size_t after = residentBytes();
+    doNotOptimize(strings);
+    double bytes = after > before ? static_cast<double>(after - before) : 0;
+    memory.push_back({variant, bytes / static_cast<double>(lengths.size())});
+}
+
+// Time and resident memory per million strings, next to the payload the strings actually hold
+void printMemory(BenchmarkHarness &harness, const std::string &group, const std::vector<MemoryResult> &memory,
+                 double payload)
+{
+    std::cout << "\n"
+              << std::left << std::setw(44) << ("Memory: " + group) << std::right << std::setw(14) << "ns/string"
+              << std::setw(20) << "MB per 1M strings" << std::setw(12) << "Overhead" << "\n";
+    std::cout << std::string(90, '-') << "\n";
+    std::cout << std::left << std::setw(44) << "payload (length + terminator)" << std::right << std::fixed
+              << std::setprecision(1) << std::setw(34) << payload << "\n";
+    for (const MemoryResult &entry : memory)
+    {
+        double median = 0;
+        for (const BenchmarkResult &result : harness.results())
+        {
+            if (result.group == group && result.variant == entry.variant)
+            {
+                median = result.stats.median;
+            }
+        }
+        std::cout << std::left << std::setw(44) << entry.variant << std::right << std::setw(14) << median;
+        if (entry.bytesPerString > 0)
+        {
+            std::cout << std::setw(20) << entry.bytesPerString << std::setw(11)
+                      << 100 * (entry.bytesPerString / payload - 1) << "%";
+        }
+        else
+        {
+            std::cout << std::setw(20) << "n/a";
+        }
+        std::cout << "\n";
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+}
+
+template <typename Build> void comparePolicies(BenchmarkHarness &harness, const std::string &group, Build build)
+{
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group + " (ns per string)");
+    const std::string text = generateText(maxLength);
+    const size_t count = harness.options().elements / 4 ? harness.options().elements / 4 : 1;
+    const std::vector<size_t> lengths = generateLengths(count);
+    double payload = 0;
+    for (size_t length : lengths)
+    {
+        payload += static_cast<double>(length + 1);
+    }
+    payload /= static_cast<double>(lengths.size());
+
+    std::vector<MemoryResult> memory;
+    auto variant = [&](auto tag, const char *name) {
+        using T = decltype(tag);
+        measureVariant<T>(
+            harness, group, name, lengths, [&](std::vector<T> &strings) { build(strings, text, lengths); }, memory);
+    };
+    variant(PowerOfTwoString(), "TString power of two");
+    variant(GeometricString(), "TString geometric 1.5x");
+    variant(ExactFitString(), "TString exact fit");
+    variant(std::string(), "std::string");
+    printMemory(harness, group, memory, payload);
+}
+} // namespace
+
+void runGrowthBenchmarks(BenchmarkHarness &harness)
+{
+    comparePolicies(harness, "Growth Construct", [](auto &strings, const std::string &text, const auto &lengths) {
+        buildExact(strings, text, lengths);
+    });
+    comparePolicies(harness, "Growth Append", [](auto &strings, const std::string &text, const auto &lengths) {
+        buildAppended(strings, text, lengths);
+    });
+}
@@ -0,0 +1,465 @@
+#include "harness.hpp"
+
+#include <algorithm>
+#include <barrier>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// Times one repetition and, in instrumented builds, adds its TString allocations to the result
+template <typename Body> double measure(BenchmarkResult &result, const Body &body)
+{
+#ifdef TSTRING_INSTRUMENT
+    TStringAllocationStats before = tstring_global_stats();
+#endif
+    auto start = Clock::now();
+    body();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+#ifdef TSTRING_INSTRUMENT
+    result.allocations += tstring_global_stats() - before;
+#else
+    (void)result;
+#endif
+    return static_cast<double>(elapsed.count());
+}
+
+#if defined(_WIN32)
+DWORD_PTR originalAffinity = 0;
+#elif defined(__linux__)
+cpu_set_t originalAffinity;
+#endif
+bool haveOriginalAffinity = false;
+
+int pinThread(int requested)
+{
+#if defined(_WIN32)
+    DWORD_PTR systemAffinity = 0;
+    haveOriginalAffinity = GetProcessAffinityMask(GetCurrentProcess(), &originalAffinity, &systemAffinity) != 0;
+    int target = requested >= 0 ? requested : static_cast<int>(GetCurrentProcessorNumber());
+    if (SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << target) == 0)
+    {
+        return -1;
+    }
+    return target;
+#elif defined(__linux__)
+    haveOriginalAffinity = pthread_getaffinity_np(pthread_self(), sizeof(originalAffinity), &originalAffinity) == 0;
+    int target = requested >= 0 ? requested : sched_getcpu();
+    if (target < 0)
+    {
+        return -1;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(target, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+    {
+        return -1;
+    }
+    return target;
+#else
+    (void)requested;
+    return -1;
+#endif
+}
+
+// Worker threads inherit the pinned affinity; give them back every CPU the process started with
+void unpinThread()
+{
+    if (!haveOriginalAffinity)
+    {
+        return;
+    }
+#if defined(_WIN32)
+    SetThreadAffinityMask(GetCurrentThread(), originalAffinity);
+#elif defined(__linux__)
+    pthread_setaffinity_np(pthread_self(), sizeof(originalAffinity), &originalAffinity);
+#endif
+}
+
+double percentile(const std::vector<double> &sorted, double fraction)
+{
+    if (sorted.empty())
+    {
+        return 0;
+    }
+    double position = fraction * static_cast<double>(sorted.size() - 1);
+    size_t lower = static_cast<size_t>(position);
+    size_t upper = lower + 1 < sorted.size() ? lower + 1 : lower;
+    double weight = position - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * weight;
+}
+
+std::string jsonEscape(const std::string &text)
+{
+    std::string escaped;
+    for (char ch : text)
+    {
+        switch (ch)
+        {
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            if (static_cast<unsigned char>(ch) < 0x20)
+            {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", ch);
+                escaped += code;
+            }
+            else
+            {
+                escaped += ch;
+            }
+        }
+    }
+    return escaped;
+}
+
+std::string compilerName()
+{
+#if defined(__clang__)
+    return std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("gcc ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string formatSize(size_t size)
+{
+    if (size >= (size_t(1) << 20) && size % (size_t(1) << 20) == 0)
+    {
+        return std::to_string(size >> 20) + "M";
+    }
+    if (size >= 1024 && size % 1024 == 0)
+    {
+        return std::to_string(size >> 10) + "K";
+    }
+    return std::to_string(size);
+}
+} // namespace
+
+std::string BenchmarkResult::name() const
+{
+    std::string result = group + "/" + variant;
+    if (size != 0)
+    {
+        result += "/" + std::to_string(size);
+    }
+    if (threads != 0)
+    {
+        result += "/" + std::to_string(threads) + "t";
+    }
+    return result;
+}
+
+BenchmarkStats computeStats(std::vector<double> samples)
+{
+    BenchmarkStats stats;
+    if (samples.empty())
+    {
+        return stats;
+    }
+    std::sort(samples.begin(), samples.end());
+    double sum = 0;
+    for (double sample : samples)
+    {
+        sum += sample;
+    }
+    stats.mean = sum / static_cast<double>(samples.size());
+    double squares = 0;
+    for (double sample : samples)
+    {
+        squares += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.variance = samples.size() > 1 ? squares / static_cast<double>(samples.size() - 1) : 0;
+    stats.median = percentile(samples, 0.5);
+    stats.p90 = percentile(samples, 0.9);
+    stats.p99 = percentile(samples, 0.99);
+    stats.min = samples.front();
+    stats.max = samples.back();
+    return stats;
+}
+
+BenchmarkHarness::BenchmarkHarness(const BenchmarkOptions &options) : config(options)
+{
+    if (config.repetitions == 0)
+    {
+        config.repetitions = 1;
+    }
+    if (config.pin)
+    {
+        cpu = pinThread(config.cpu);
+        if (cpu < 0)
+        {
+            std::cerr << "Could not pin the benchmark thread to a CPU; results may be noisier." << std::endl;
+        }
+    }
+}
+
+bool BenchmarkHarness::enabled(const std::string &group) const
+{
+    return config.filter.empty() || group.find(config.filter) != std::string::npos;
+}
+
+std::vector<size_t> BenchmarkHarness::sizes() const
+{
+    std::vector<size_t> result;
+    for (size_t size = 1; size <= config.maxSize; size *= 8)
+    {
+        result.push_back(size);
+    }
+    if (result.empty() || result.back() != config.maxSize)
+    {
+        result.push_back(config.maxSize);
+    }
+    return result;
+}
+
+void BenchmarkHarness::section(const std::string &title)
+{
+    std::cout << "\n"
+              << std::left << std::setw(44) << title << std::right << std::setw(8) << "Size" << std::setw(14)
+              << "Median ns" << std::setw(14) << "P90 ns" << std::setw(14) << "P99 ns" << std::setw(10) << "CV %";
+#ifdef TSTRING_INSTRUMENT
+    std::cout << std::setw(12) << "Allocs/op" << std::setw(12) << "Grows/op" << std::setw(14) << "Copied B/op";
+    std::cout << "\n" << std::string(142, '-') << "\n";
+#else
+    std::cout << "\n" << std::string(104, '-') << "\n";
+#endif
+}
+
+void BenchmarkHarness::run(const std::string &group, const std::string &variant, size_t size,
+                           const std::function<void(size_t)> &body)
+{
+    measureRepeated(group, variant, size, 0, body);
+}
+
+void BenchmarkHarness::runParallel(const std::string &group, const std::string &variant, size_t threads,
+                                   const std::function<void(size_t, size_t)> &body)
+{
+    // Workers live for the whole case; each repetition is one pass between two barrier phases
+    std::barrier sync(static_cast<std::ptrdiff_t>(threads + 1));
+    size_t count = 0;
+    bool stop = false;
+    std::vector<std::thread> workers;
+    for (size_t thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([&, thread] {
+            unpinThread();
+            for (;;)
+            {
+                sync.arrive_and_wait();
+                if (stop)
+                {
+                    return;
+                }
+                body(thread, count);
+                sync.arrive_and_wait();
+            }
+        });
+    }
+
+    measureRepeated(group, variant, 0, threads, [&](size_t iterations) {
+        count = iterations;
+        sync.arrive_and_wait();
+        sync.arrive_and_wait();
+    });
+
+    stop = true;
+    sync.arrive_and_wait();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void BenchmarkHarness::measureRepeated(const std::string &group, const std::string &variant, size_t size,
+                                       size_t threads, const std::function<void(size_t)> &body)
+{
+    size_t iterations = config.fixedIterations;
+    if (iterations == 0)
+    {
+        iterations = 1;
+        for (;;)
+        {
+            auto start = Clock::now();
+            body(iterations);
+            auto elapsed = Clock::now() - start;
+            if (elapsed >= config.minRepetitionTime || iterations >= (size_t(1) << 40))
+            {
+                break;
+            }
+            double ratio = elapsed.count() > 0 ? double(config.minRepetitionTime.count()) / double(elapsed.count())
+                                               : 100.0;
+            ratio = std::clamp(ratio * 1.2, 2.0, 100.0);
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * ratio);
+        }
+    }
+
+    for (size_t i = 0; i < config.warmupRepetitions; ++i)
+    {
+        body(iterations);
+    }
+
+    BenchmarkResult result;
+    result.group = group;
+    result.variant = variant;
+    result.size = size;
+    result.threads = threads;
+    result.iterations = iterations * (threads ? threads : 1);
+    for (size_t i = 0; i < config.repetitions; ++i)
+    {
+        double elapsed = measure(result, [&] { body(iterations); });
+        result.samples.push_back(elapsed / static_cast<double>(result.iterations));
+    }
+    record(std::move(result));
+}
+
+void BenchmarkHarness::runBatch(const std::string &group, const std::string &variant, size_t size, size_t items,
+                                const std::function<void()> &setup, const std::function<void()> &body, size_t bytes)
+{
+    if (items == 0)
+    {
+        items = 1;
+    }
+    for (size_t i = 0; i < config.warmupRepetitions; ++i)
+    {
+        setup();
+        body();
+    }
+
+    BenchmarkResult result;
+    result.group = group;
+    result.variant = variant;
+    result.size = size;
+    result.iterations = items;
+    result.bytesPerOperation = static_cast<double>(bytes) / static_cast<double>(items);
+    for (size_t i = 0; i < config.repetitions; ++i)
+    {
+        setup();
+        double elapsed = measure(result, body);
+        result.samples.push_back(elapsed / static_cast<double>(items));
+    }
+    record(std::move(result));
+}
+
+void BenchmarkHarness::record(BenchmarkResult result)
+{
+    result.stats = computeStats(result.samples);
+    const BenchmarkStats &stats = result.stats;
+    double cv = stats.mean > 0 ? 100.0 * std::sqrt(stats.variance) / stats.mean : 0;
+
+    std::string label = result.group + "/" + result.variant;
+    if (result.threads != 0)
+    {
+        label += " x" + std::to_string(result.threads);
+    }
+    std::cout << std::left << std::setw(44) << label << std::right << std::setw(8)
+              << (result.size ? formatSize(result.size) : "-") << std::fixed << std::setprecision(2)
+              << std::setw(14) << stats.median << std::setw(14) << stats.p90 << std::setw(14) << stats.p99
+              << std::setw(10) << std::setprecision(1) << cv;
+#ifdef TSTRING_INSTRUMENT
+    double operations = static_cast<double>(result.iterations * result.samples.size());
+    std::cout << std::setprecision(2) << std::setw(12) << double(result.allocations.allocations) / operations
+              << std::setw(12) << double(result.allocations.growths) / operations << std::setw(14)
+              << double(result.allocations.bytesCopied) / operations;
+#endif
+    std::cout << "\n";
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout << std::setprecision(6);
+    collected.push_back(std::move(result));
+}
+
+bool BenchmarkHarness::exportJson(const std::string &path) const
+{
+    std::ofstream out(path);
+    if (!out.is_open())
+    {
+        return false;
+    }
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32] = {};
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    out << std::setprecision(17);
+    out << "{\n";
+    out << "  \"schema\": \"tstring-benchmark\",\n";
+    out << "  \"schema_version\": " << benchmarkSchemaVersion << ",\n";
+    out << "  \"environment\": {\n";
+    out << "    \"compiler\": \"" << jsonEscape(compilerName()) << "\",\n";
+    out << "    \"timestamp\": \"" << timestamp << "\",\n";
+    out << "    \"pinned_cpu\": " << cpu << ",\n";
+#ifdef TSTRING_INSTRUMENT
+    out << "    \"instrumented\": true,\n";
+#else
+    out << "    \"instrumented\": false,\n";
+#endif
+    out << "    \"repetitions\": " << config.repetitions << ",\n";
+    out << "    \"warmup_repetitions\": " << config.warmupRepetitions << ",\n";
+    out << "    \"min_repetition_ns\": " << config.minRepetitionTime.count() << "\n";
+    out << "  },\n";
+    out << "  \"results\": [";
+    for (size_t i = 0; i < collected.size(); ++i)
+    {
+        const BenchmarkResult &result = collected[i];
+        const BenchmarkStats &stats = result.stats;
+        out << (i ? ",\n" : "\n");
+        out << "    {\"name\": \"" << jsonEscape(result.name()) << "\", \"group\": \"" << jsonEscape(result.group)
+            << "\", \"variant\": \"" << jsonEscape(result.variant) << "\", \"size\": " << result.size
+            << ", \"threads\": " << result.threads << ", \"unit\": \"ns/op\", \"iterations\": " << result.iterations
+            << ", \"bytes_per_op\": " << result.bytesPerOperation << ",\n";
+        out << "     \"median\": " << stats.median << ", \"p90\": " << stats.p90 << ", \"p99\": " << stats.p99
+            << ", \"mean\": " << stats.mean << ", \"variance\": " << stats.variance << ", \"min\": " << stats.min
+            << ", \"max\": " << stats.max << ",\n";
+#ifdef TSTRING_INSTRUMENT
+        const TStringAllocationStats &allocations = result.allocations;
+        out << "     \"allocations\": {\"operations\": " << result.iterations * result.samples.size()
+            << ", \"allocations\": " << allocations.allocations << ", \"frees\": " << allocations.frees
+            << ", \"growths\": " << allocations.growths << ", \"bytes_allocated\": " << allocations.bytesAllocated
+            << ", \"bytes_copied\": " << allocations.bytesCopied << ", \"size_classes\": [";
+        for (size_t c = 0; c < TStringAllocationStats::sizeClassCount; ++c)
+        {
+            out << (c ? ", " : "") << allocations.sizeClasses[c];
+        }
+        out << "]},\n";
+#endif
+        out << "     \"samples\": [";
+        for (size_t s = 0; s < result.samples.size(); ++s)
+        {
+            out << (s ? ", " : "") << result.samples[s];
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n";
+    out << "}\n";
+    return out.good();
+}
@@ -0,0 +1,180 @@
+#ifndef TSTRING_BENCHMARK_HARNESS_HPP
+#define TSTRING_BENCHMARK_HARNESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef TSTRING_INSTRUMENT
+#include "TStringInstrument.hpp"
+#endif
+
+// Version of the JSON document written by --export. Bump it whenever a field
+// is renamed, removed or changes meaning.
+constexpr int benchmarkSchemaVersion = 1;
+
+struct BenchmarkOptions
+{
+    size_t repetitions = 11;
+    size_t warmupRepetitions = 2;
+    std::chrono::nanoseconds minRepetitionTime = std::chrono::milliseconds(10);
+    // Operations per repetition; 0 calibrates against minRepetitionTime
+    size_t fixedIterations = 0;
+    // Collection size for the sort, compare, map and growth benchmarks
+    size_t elements = 1000000;
+    // Largest string size in the size sweeps
+    size_t maxSize = size_t(64) << 20;
+    // CPU to pin the benchmark thread to; -1 pins to the current CPU
+    int cpu = -1;
+    bool pin = true;
+    // Largest thread count for the scaling benchmarks; 0 skips them
+    size_t threads = 0;
+    std::string filter;
+    bool exportResults = false;
+    std::string exportPath = "tstring_performance_results.json";
+    // --export file to compare this run with, empty when not comparing
+    std::string comparePath;
+    // Slowdown in percent that counts as a regression when it is significant
+    double regressionThreshold = 5.0;
+    double significance = 0.05;
+};
+
+struct BenchmarkStats
+{
+    double median = 0;
+    double p90 = 0;
+    double p99 = 0;
+    double mean = 0;
+    double variance = 0;
+    double min = 0;
+    double max = 0;
+};
+
+// One benchmark case. Every sample is the mean time of one operation, in
+// nanoseconds, over one repetition.
+struct BenchmarkResult
+{
+    std::string group;
+    std::string variant;
+    size_t size = 0;
+    // Thread count of a runParallel case, 0 for single-threaded cases
+    size_t threads = 0;
+    // Operations per repetition, over all threads
+    size_t iterations = 0;
+    // Bytes processed per operation, 0 when not measured
+    double bytesPerOperation = 0;
+    std::vector<double> samples;
+    BenchmarkStats stats;
+#ifdef TSTRING_INSTRUMENT
+    // TString allocations made by the timed repetitions, on every thread
+    TStringAllocationStats allocations;
+#endif
+
+    std::string name() const;
+};
+
+BenchmarkStats computeStats(std::vector<double> samples);
+
+// Keeps the compiler from discarding a value or the computation behind it.
+template <typename T> inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    const volatile char *sink = reinterpret_cast<const volatile char *>(&value);
+    (void)*sink;
+#endif
+}
+
+template <typename T> inline void doNotOptimize(T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : "+r,m"(value) : : "memory");
+#else
+    volatile char *sink = reinterpret_cast<volatile char *>(&value);
+    *sink = *sink;
+#endif
+}
+
+class BenchmarkHarness
+{
+  public:
+    explicit BenchmarkHarness(const BenchmarkOptions &options);
+
+    const BenchmarkOptions &options() const
+    {
+        return config;
+    }
+
+    int pinnedCpu() const
+    {
+        return cpu;
+    }
+
+    // Whether a group passes the --filter option
+    bool enabled(const std::string &group) const;
+
+    // String sizes for the sweeps: 1 byte to maxSize, growing by 8x
+    std::vector<size_t> sizes() const;
+
+    void section(const std::string &title);
+
+    // body(n) performs n operations. The iteration count is calibrated so one
+    // repetition lasts at least minRepetitionTime.
+    void run(const std::string &group, const std::string &variant, size_t size,
+             const std::function<void(size_t)> &body);
+
+    // Runs body(thread, n) on the given number of threads at once, each thread
+    // performing n operations. Samples are wall time divided by all operations,
+    // so they are the inverse of the combined throughput.
+    void runParallel(const std::string &group, const std::string &variant, size_t threads,
+                     const std::function<void(size_t, size_t)> &body);
+
+    // For operations that consume their input: setup() runs untimed before
+    // every repetition, body() performs items operations once. bytes is the
+    // amount of data one body() call processes, for throughput reporting.
+    void runBatch(const std::string &group, const std::string &variant, size_t size, size_t items,
+                  const std::function<void()> &setup, const std::function<void()> &body, size_t bytes = 0);
+
+    const std::vector<BenchmarkResult> &results() const
+    {
+        return collected;
+    }
+
+    bool exportJson(const std::string &path) const;
+
+  private:
+    BenchmarkOptions config;
+    int cpu = -1;
+    std::vector<BenchmarkResult> collected;
+
+    void measureRepeated(const std::string &group, const std::string &variant, size_t size, size_t threads,
+                         const std::function<void(size_t)> &body);
+    void record(BenchmarkResult result);
+};
+
+void runCoreBenchmarks(BenchmarkHarness &harness);
+void runGrowthBenchmarks(BenchmarkHarness &harness);
+void runSortBenchmarks(BenchmarkHarness &harness);
+void runCompactBenchmarks(BenchmarkHarness &harness);
+void runMapBenchmarks(BenchmarkHarness &harness);
+void runSwitchBenchmarks(BenchmarkHarness &harness);
+void runThreadBenchmarks(BenchmarkHarness &harness);
+void runWorkloadBenchmarks(BenchmarkHarness &harness);
+void runArchiveBenchmarks(BenchmarkHarness &harness);
+void runTokenizerBenchmarks(BenchmarkHarness &harness);
+void runPatternBenchmarks(BenchmarkHarness &harness);
+void runFuzzyBenchmarks(BenchmarkHarness &harness);
+void runHashBenchmarks(BenchmarkHarness &harness);
+void runInteropBenchmarks(BenchmarkHarness &harness);
+
+// Compares the results with a file written by --export and prints the change
+// of every case found in both. Returns the number of significant regressions
+// beyond the threshold, or -1 if the baseline can't be used: it is unreadable,
+// comes from a build with different instrumentation, or shares no case with
+// this run.
+int compareWithBaseline(const BenchmarkHarness &harness, const std::string &path);
+
+#endif // TSTRING_BENCHMARK_HARNESS_HPP
@@ -0,0 +1,77 @@
+#include "TString.hpp"
+#include "TStringHash.hpp"
+
+#include "harness.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// The hashing step of a group-by: a large array of short TString keys,
+// hashed one call at a time against the batch API. The keys are shuffled
+// after they are created, so consecutive keys sit in unrelated heap blocks
+// as they would after a scan or a sort.
+
+namespace
+{
+std::vector<TString> generateKeys(size_t count, size_t length)
+{
+    std::mt19937_64 rng(43 + length);
+    std::vector<TString> keys;
+    keys.reserve(count);
+    std::string key(length, ' ');
+    for (size_t i = 0; i < count; ++i)
+    {
+        for (char &ch : key)
+        {
+            ch = static_cast<char>('a' + rng() % 26);
+        }
+        keys.push_back(TString(key));
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+}
+} // namespace
+
+void runHashBenchmarks(BenchmarkHarness &harness)
+{
+    const std::string group = "Hash batch";
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group + " (ns per key)");
+    const size_t count = harness.options().elements;
+    std::vector<uint64_t> hashes(count);
+    std::vector<uint64_t> batchHashes(count);
+    std::vector<uint32_t> fnv(count);
+    std::vector<uint32_t> batchFnv(count);
+
+    for (size_t length : {4, 8, 16, 32, 64})
+    {
+        const std::vector<TString> keys = generateKeys(count, length);
+        harness.runBatch(group, "tstring_hash per key", length, count, [] {}, [&] {
+            for (size_t i = 0; i < count; ++i)
+            {
+                hashes[i] = tstring_hash(keys[i]);
+            }
+        });
+        harness.runBatch(group, "tstring_hash_batch", length, count, [] {},
+                         [&] { tstring_hash_batch(keys, batchHashes); });
+        harness.runBatch(group, "tstring_hash_fnv per key", length, count, [] {}, [&] {
+            for (size_t i = 0; i < count; ++i)
+            {
+                fnv[i] = tstring_hash_fnv(keys[i]);
+            }
+        });
+        harness.runBatch(group, "tstring_hash_fnv_batch", length, count, [] {},
+                         [&] { tstring_hash_fnv_batch(keys, batchFnv); });
+        if (hashes != batchHashes || fnv != batchFnv)
+        {
+            std::cerr << "Batch hashes differ from tstring_hash at " << length << " bytes" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+#include "TStringInterop.hpp"
+
+#include "harness.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A batch of strings crossing the boundary between code written against
+// std::string and code written against TString, both ways. The loops convert
+// one element at a time through c_str(), the way such glue is usually written;
+// the bulk functions size their output once and pass lengths along.
+
+namespace
+{
+std::vector<std::string> generateStrings(size_t count)
+{
+    std::mt19937_64 rng(45);
+    std::vector<std::string> strings;
+    strings.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string str(1 + rng() % 64, ' ');
+        for (char &ch : str)
+        {
+            ch = static_cast<char>('a' + rng() % 26);
+        }
+        strings.push_back(std::move(str));
+    }
+    return strings;
+}
+} // namespace
+
+void runInteropBenchmarks(BenchmarkHarness &harness)
+{
+    const std::string group = "Interop";
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group + " (ns per string)");
+    const size_t count = harness.options().elements / 10;
+    const std::vector<std::string> strings = generateStrings(count);
+    const std::vector<TString> tstrings = tstring_from_strings(strings);
+
+    harness.runBatch(group, "std::string -> TString loop", 0, count, [] {}, [&] {
+        std::vector<TString> converted;
+        for (const std::string &str : strings)
+        {
+            converted.push_back(TString(str.c_str()));
+        }
+        doNotOptimize(converted);
+    });
+    harness.runBatch(group, "tstring_from_strings", 0, count, [] {}, [&] {
+        std::vector<TString> converted = tstring_from_strings(strings);
+        doNotOptimize(converted);
+    });
+    harness.runBatch(group, "std::string -> TStringColumn loop", 0, count, [] {}, [&] {
+        TStringColumn column;
+        for (const std::string &str : strings)
+        {
+            column.push_back(str.c_str());
+        }
+        doNotOptimize(column);
+    });
+    harness.runBatch(group, "tstring_column_from_strings", 0, count, [] {}, [&] {
+        TStringColumn column = tstring_column_from_strings(strings);
+        doNotOptimize(column);
+    });
+    harness.runBatch(group, "TString -> std::string loop", 0, count, [] {}, [&] {
+        std::vector<std::string> converted;
+        for (const TString &str : tstrings)
+        {
+            converted.push_back(std::string(str.c_str()));
+        }
+        doNotOptimize(converted);
+    });
+    harness.runBatch(group, "tstring_to_strings", 0, count, [] {}, [&] {
+        std::vector<std::string> converted = tstring_to_strings(tstrings);
+        doNotOptimize(converted);
+    });
+    harness.runBatch(group, "tstring_views", 0, count, [] {}, [&] {
+        std::vector<std::string_view> views = tstring_views(tstrings);
+        doNotOptimize(views);
+    });
+
+    if (tstring_to_strings(tstrings) != strings || tstring_to_strings(tstring_column_from_strings(strings)) != strings)
+    {
+        std::cerr << "Converted strings differ from the originals" << std::endl;
+    }
+}
@@ -0,0 +1,166 @@
+#include "harness.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+void printUsage()
+{
+    std::cout << "Usage: program_name [OPTIONS]\n";
+    std::cout << "Options:\n";
+    std::cout << "  -e, --export [FILE]   Export results as JSON (default: tstring_performance_results.json)\n";
+    std::cout << "  -c, --compare FILE    Compare with an exported baseline; exit with 2 on significant regressions\n";
+    std::cout << "      --threshold PCT   Slowdown that counts as a regression (default: 5)\n";
+    std::cout << "      --alpha P         Significance level of the comparison (default: 0.05)\n";
+    std::cout << "  -r, --repetitions N   Timed repetitions per benchmark (default: 11)\n";
+    std::cout << "  -w, --warmup N        Untimed warm-up repetitions per benchmark (default: 2)\n";
+    std::cout << "  -t, --min-time MS     Minimum duration of one repetition in ms (default: 10)\n";
+    std::cout << "  -i, --iterations N    Fixed operations per repetition instead of calibrating\n";
+    std::cout << "  -n, --elements N      Collection size for the sort, map and growth benchmarks (default: 1000000)\n";
+    std::cout << "  -s, --max-size BYTES  Largest string in the size sweeps (default: 67108864)\n";
+    std::cout << "  -f, --filter TEXT     Only run benchmark groups whose name contains TEXT\n";
+    std::cout << "  -j, --threads N       Run the thread scaling benchmarks with up to N threads\n";
+    std::cout << "      --cpu N           Pin the benchmark thread to CPU N (default: the current CPU)\n";
+    std::cout << "      --no-pin          Do not pin the benchmark thread\n";
+    std::cout << "  -h, --help            Display this help message\n";
+}
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        auto is = [&](const char *shortName, const char *longName) {
+            return (shortName && strcmp(argv[i], shortName) == 0) || strcmp(argv[i], longName) == 0;
+        };
+        bool hasValue = i + 1 < argc;
+
+        if (is("-e", "--export"))
+        {
+            options.exportResults = true;
+            if (hasValue && argv[i + 1][0] != '-')
+            {
+                options.exportPath = argv[++i];
+            }
+        }
+        else if (is("-c", "--compare") && hasValue)
+        {
+            options.comparePath = argv[++i];
+        }
+        else if (is(nullptr, "--threshold") && hasValue)
+        {
+            options.regressionThreshold = std::strtod(argv[++i], nullptr);
+        }
+        else if (is(nullptr, "--alpha") && hasValue)
+        {
+            options.significance = std::strtod(argv[++i], nullptr);
+        }
+        else if (is("-r", "--repetitions") && hasValue)
+        {
+            options.repetitions = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (is("-w", "--warmup") && hasValue)
+        {
+            options.warmupRepetitions = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (is("-t", "--min-time") && hasValue)
+        {
+            options.minRepetitionTime = std::chrono::milliseconds(std::strtoull(argv[++i], nullptr, 10));
+        }
+        else if (is("-i", "--iterations") && hasValue)
+        {
+            options.fixedIterations = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (is("-n", "--elements") && hasValue)
+        {
+            options.elements = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (is("-s", "--max-size") && hasValue)
+        {
+            options.maxSize = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (is("-f", "--filter") && hasValue)
+        {
+            options.filter = argv[++i];
+        }
+        else if (is("-j", "--threads") && hasValue)
+        {
+            options.threads = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (is(nullptr, "--cpu") && hasValue)
+        {
+            options.cpu = std::atoi(argv[++i]);
+        }
+        else if (is(nullptr, "--no-pin"))
+        {
+            options.pin = false;
+        }
+        else if (is("-h", "--help"))
+        {
+            printUsage();
+            return 0;
+        }
+        else
+        {
+            printUsage();
+            return 1;
+        }
+    }
+    if (options.maxSize == 0 || options.elements == 0)
+    {
+        std::cerr << "--max-size and --elements must be positive." << std::endl;
+        return 1;
+    }
+    if (options.significance <= 0 || options.significance >= 1)
+    {
+        std::cerr << "--alpha must be between 0 and 1." << std::endl;
+        return 1;
+    }
+
+    BenchmarkHarness harness(options);
+    std::cout << "Times are nanoseconds per operation over " << harness.options().repetitions << " repetitions";
+    if (harness.pinnedCpu() >= 0)
+    {
+        std::cout << ", pinned to CPU " << harness.pinnedCpu();
+    }
+    std::cout << "\n";
+#ifdef TSTRING_INSTRUMENT
+    std::cout << "Instrumented build: allocation counters are on and add to the measured times\n";
+#endif
+
+    runCoreBenchmarks(harness);
+    runGrowthBenchmarks(harness);
+    runSortBenchmarks(harness);
+    runCompactBenchmarks(harness);
+    runMapBenchmarks(harness);
+    runHashBenchmarks(harness);
+    runSwitchBenchmarks(harness);
+    runWorkloadBenchmarks(harness);
+    runArchiveBenchmarks(harness);
+    runInteropBenchmarks(harness);
+    runTokenizerBenchmarks(harness);
+    runPatternBenchmarks(harness);
+    runFuzzyBenchmarks(harness);
+    runThreadBenchmarks(harness);
+
+    // Compare before exporting, which may overwrite the baseline
+    int status = 0;
+    if (!options.comparePath.empty())
+    {
+        int regressions = compareWithBaseline(harness, options.comparePath);
+        status = regressions < 0 ? 1 : regressions > 0 ? 2 : 0;
+    }
+
+    if (options.exportResults)
+    {
+        if (!harness.exportJson(options.exportPath))
+        {
+            std::cerr << "Failed to open file for writing test results." << std::endl;
+            return 1;
+        }
+        std::cout << "Performance test completed. Results saved to " << options.exportPath << std::endl;
+    }
+    return status;
+}
@@ -0,0 +1,86 @@
+#include "TStringMap.hpp"
+
+#include "data.hpp"
+#include "harness.hpp"
+
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+template <typename Map> void insertAll(Map &map, const std::vector<TString> &keys)
+{
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        map.emplace(keys[i], i);
+    }
+}
+
+template <typename Map> size_t countFound(const Map &map, const std::vector<TString> &keys, size_t iterations)
+{
+    size_t found = 0;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        found += map.contains(keys[(i * 7919) % keys.size()]);
+    }
+    return found;
+}
+
+// Runs one map implementation through insert, hit, miss and erase
+template <typename Map>
+void mapCases(BenchmarkHarness &harness, const char *variant, const std::vector<TString> &keys,
+              const std::vector<TString> &missing)
+{
+    Map map;
+    harness.runBatch("Map Insert", variant, keys.size(), keys.size(), [&] { map = Map(); },
+                     [&] { insertAll(map, keys); });
+
+    map = Map();
+    insertAll(map, keys);
+    harness.run("Map FindHit", variant, keys.size(), [&](size_t iterations) {
+        size_t found = countFound(map, keys, iterations);
+        doNotOptimize(found);
+    });
+    harness.run("Map FindMiss", variant, keys.size(), [&](size_t iterations) {
+        size_t found = countFound(map, missing, iterations);
+        doNotOptimize(found);
+    });
+    if (countFound(map, keys, keys.size()) != keys.size() || countFound(map, missing, missing.size()) != 0)
+    {
+        std::cerr << variant << " lookups returned wrong results" << std::endl;
+    }
+
+    harness.runBatch("Map Erase", variant, keys.size(), keys.size(),
+                     [&] {
+                         map = Map();
+                         insertAll(map, keys);
+                     },
+                     [&] {
+                         for (const TString &key : keys)
+                         {
+                             map.erase(key);
+                         }
+                     });
+}
+} // namespace
+
+// Insert, lookup and erase at growing map sizes
+void runMapBenchmarks(BenchmarkHarness &harness)
+{
+    if (!harness.enabled("Map"))
+    {
+        return;
+    }
+    harness.section("Map (size = entries)");
+    for (size_t entries = 1000; entries <= harness.options().elements; entries *= 10)
+    {
+        std::vector<std::string> rawKeys = generateUrlKeys(2 * entries);
+        std::vector<TString> keys(rawKeys.begin(), rawKeys.begin() + entries);
+        std::vector<TString> missing(rawKeys.begin() + entries, rawKeys.end());
+
+        mapCases<TStringMap<size_t>>(harness, "TStringMap", keys, missing);
+        mapCases<std::unordered_map<TString, size_t>>(harness, "unordered_map", keys, missing);
+    }
+}
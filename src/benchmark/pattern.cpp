@@ -0,0 +1,171 @@
+#include "TString.hpp"
+#include "TStringColumn.hpp"
+#include "TStringPattern.hpp"
+
+#include "harness.hpp"
+
+#include <iostream>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+// Filtering metric keys such as "svc.billing-3.latency_p99" with a wildcard
+// pattern: a compiled TStringPattern over a TStringColumn, a matcher built
+// from substr the way such filters are often written, and std::regex.
+
+namespace
+{
+const char *const services[] = {"api", "auth", "billing", "cache", "db", "gateway", "search", "users"};
+const char *const metrics[] = {"latency_p50", "latency_p90", "latency_p99", "errors", "requests", "bytes_out"};
+const char *const patterns[] = {"svc.*.latency_p9?", "*.db-?.errors"};
+
+std::vector<TString> generateKeys(size_t count)
+{
+    std::mt19937_64 rng(31);
+    std::vector<TString> keys;
+    keys.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string key = rng() % 4 == 0 ? "host." : "svc.";
+        key += services[rng() % 8];
+        key += '-';
+        key += std::to_string(rng() % 12);
+        key += '.';
+        key += metrics[rng() % 6];
+        keys.push_back(TString(key));
+    }
+    return keys;
+}
+
+// Compares a star-free part that may hold '?'
+bool samePart(const TString &part, const TString &text)
+{
+    for (size_t i = 0; i < part.size(); ++i)
+    {
+        if (part[i] != '?' && part[i] != text[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Splits the pattern at '*' on every call and compares candidate substrings, allocating each one
+bool naiveMatch(const TString &pattern, const TString &key)
+{
+    std::vector<TString> parts;
+    size_t start = 0;
+    for (size_t i = 0; i <= pattern.size(); ++i)
+    {
+        if (i == pattern.size() || pattern[i] == '*')
+        {
+            parts.push_back(pattern.substr(start, i - start));
+            start = i + 1;
+        }
+    }
+    const TString &head = parts.front();
+    const TString &tail = parts.back();
+    if (parts.size() == 1)
+    {
+        return key.size() == head.size() && samePart(head, key);
+    }
+    if (key.size() < head.size() + tail.size() || !samePart(head, key.substr(0, head.size())) ||
+        !samePart(tail, key.substr(key.size() - tail.size())))
+    {
+        return false;
+    }
+    size_t pos = head.size();
+    size_t end = key.size() - tail.size();
+    for (size_t p = 1; p + 1 < parts.size(); ++p)
+    {
+        const TString &part = parts[p];
+        while (pos + part.size() <= end && !samePart(part, key.substr(pos, part.size())))
+        {
+            ++pos;
+        }
+        if (pos + part.size() > end)
+        {
+            return false;
+        }
+        pos += part.size();
+    }
+    return true;
+}
+
+std::regex globToRegex(const std::string &pattern)
+{
+    std::string expression;
+    for (char ch : pattern)
+    {
+        if (ch == '*')
+        {
+            expression += ".*";
+        }
+        else if (ch == '?')
+        {
+            expression += '.';
+        }
+        else
+        {
+            if (std::string(".+()[]{}^$|\\").find(ch) != std::string::npos)
+            {
+                expression += '\\';
+            }
+            expression += ch;
+        }
+    }
+    return std::regex(expression, std::regex::ECMAScript | std::regex::optimize);
+}
+} // namespace
+
+void runPatternBenchmarks(BenchmarkHarness &harness)
+{
+    const std::string group = "Glob filter";
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group + " (ns per key)");
+    const size_t count = harness.options().elements / 10;
+    const std::vector<TString> keys = generateKeys(count);
+    TStringColumn column;
+    for (const TString &key : keys)
+    {
+        column.push_back(key);
+    }
+
+    for (const char *text : patterns)
+    {
+        const std::string label = std::string(" ") + text;
+        const TString pattern(text);
+        const TStringPattern compiled(text);
+        const std::regex expression = globToRegex(text);
+        size_t compiledMatches = 0;
+        size_t naiveMatches = 0;
+        size_t regexMatches = 0;
+
+        harness.runBatch(group, "TStringPattern" + label, 0, count, [] {},
+                         [&] { compiledMatches = compiled.filter(column).size(); });
+        harness.runBatch(group, "naive substr" + label, 0, count, [] {}, [&] {
+            naiveMatches = 0;
+            for (const TString &key : keys)
+            {
+                naiveMatches += naiveMatch(pattern, key);
+            }
+        });
+        harness.runBatch(group, "std::regex" + label, 0, count, [] {}, [&] {
+            regexMatches = 0;
+            for (size_t i = 0; i < column.size(); ++i)
+            {
+                TStringConst key = column[i];
+                regexMatches += std::regex_match(key.c_str(), key.c_str() + key.size(), expression);
+            }
+        });
+        if (compiledMatches != naiveMatches || compiledMatches != regexMatches)
+        {
+            std::cerr << "Glob filters disagree on " << text << ": " << compiledMatches << ", " << naiveMatches
+                      << " and " << regexMatches << " matches" << std::endl;
+        }
+    }
+}
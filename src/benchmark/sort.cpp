@@ -0,0 +1,51 @@
+#include "TStringSort.hpp"
+
+#include "data.hpp"
+#include "harness.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+void sortKeys(BenchmarkHarness &harness, const std::string &group, const std::vector<std::string> &keys)
+{
+    const std::vector<TString> source(keys.begin(), keys.end());
+    std::vector<TString> sorted;
+
+    harness.runBatch(group, "tstring_sort", 0, keys.size(), [&] { sorted = source; }, [&] { tstring_sort(sorted); });
+    std::vector<TString> radixSorted = sorted;
+
+    harness.runBatch(group, "std::sort", 0, keys.size(), [&] { sorted = source; },
+                     [&] { std::sort(sorted.begin(), sorted.end()); });
+    if (radixSorted != sorted)
+    {
+        std::cerr << "tstring_sort result differs from std::sort for " << group << std::endl;
+    }
+
+    TStringColumn column;
+    harness.runBatch(
+        group, "column", 0, keys.size(),
+        [&] {
+            column.clear();
+            for (const std::string &key : keys)
+            {
+                column.push_back(key.c_str(), key.size());
+            }
+        },
+        [&] { tstring_sort(column); });
+}
+} // namespace
+
+void runSortBenchmarks(BenchmarkHarness &harness)
+{
+    if (!harness.enabled("Sort"))
+    {
+        return;
+    }
+    harness.section("Sort (ns per key)");
+    sortKeys(harness, "Sort (URL)", generateUrlKeys(harness.options().elements));
+    sortKeys(harness, "Sort (Random)", generateRandomKeys(harness.options().elements));
+}
@@ -0,0 +1,76 @@
+#include "TStringSwitch.hpp"
+
+#include "harness.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+const char *const dispatchKeywords[] = {"GET", "SET", "DEL", "INCR", "DECR", "MGET", "MSET", "EXISTS",
+                                        "EXPIRE", "TTL", "KEYS", "SCAN", "HGET", "HSET", "HDEL", "LPUSH",
+                                        "RPUSH", "LPOP", "RPOP", "LLEN", "SADD", "SREM", "SMEMBERS", "ZADD",
+                                        "ZREM", "ZRANGE", "PING", "ECHO", "INFO", "FLUSHALL", "SELECT", "AUTH"};
+
+constexpr TStringSwitch dispatchSwitch({"GET", "SET", "DEL", "INCR", "DECR", "MGET", "MSET", "EXISTS",
+                                        "EXPIRE", "TTL", "KEYS", "SCAN", "HGET", "HSET", "HDEL", "LPUSH",
+                                        "RPUSH", "LPOP", "RPOP", "LLEN", "SADD", "SREM", "SMEMBERS", "ZADD",
+                                        "ZREM", "ZRANGE", "PING", "ECHO", "INFO", "FLUSHALL", "SELECT", "AUTH"});
+
+size_t dispatchChained(const TString &command)
+{
+    for (size_t i = 0; i < sizeof(dispatchKeywords) / sizeof(dispatchKeywords[0]); ++i)
+    {
+        if (command == dispatchKeywords[i])
+        {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+template <typename Dispatch> size_t dispatchAll(const std::vector<TString> &commands, size_t iterations, Dispatch fn)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < iterations; ++i)
+    {
+        sum += fn(commands[i & 4095]);
+    }
+    return sum;
+}
+} // namespace
+
+// Keyword dispatch: chained == against the compile-time perfect hash
+void runSwitchBenchmarks(BenchmarkHarness &harness)
+{
+    if (!harness.enabled("Dispatch"))
+    {
+        return;
+    }
+    harness.section("Dispatch (32 keywords)");
+
+    std::mt19937_64 rng(3);
+    std::vector<TString> commands;
+    for (size_t i = 0; i < 4096; ++i)
+    {
+        // One in ten commands is unknown
+        commands.push_back(rng() % 10 == 0 ? TString("UNKNOWN") : TString(dispatchKeywords[rng() % 32]));
+    }
+    auto lookup = [](const TString &command) { return dispatchSwitch.lookup(command); };
+
+    harness.run("Dispatch", "chained ==", 0, [&](size_t iterations) {
+        size_t sum = dispatchAll(commands, iterations, dispatchChained);
+        doNotOptimize(sum);
+    });
+    harness.run("Dispatch", "TStringSwitch", 0, [&](size_t iterations) {
+        size_t sum = dispatchAll(commands, iterations, lookup);
+        doNotOptimize(sum);
+    });
+
+    if (dispatchAll(commands, 4096, dispatchChained) != dispatchAll(commands, 4096, lookup))
+    {
+        std::cerr << "TStringSwitch results differ from chained comparisons" << std::endl;
+    }
+}
@@ -0,0 +1,269 @@
+#include "TString.hpp"
+#include "TStringAppendBuffer.hpp"
+
+#include "data.hpp"
+#include "harness.hpp"
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Bounded single-producer, single-consumer ring used to move strings between threads
+template <typename T> class HandoffQueue
+{
+  public:
+    explicit HandoffQueue(size_t capacity) : slots(capacity), mask(capacity - 1)
+    {
+    }
+
+    void push(T &&value)
+    {
+        size_t tail = tailIndex.load(std::memory_order_relaxed);
+        while (tail - headIndex.load(std::memory_order_acquire) == slots.size())
+        {
+            std::this_thread::yield();
+        }
+        slots[tail & mask] = std::move(value);
+        tailIndex.store(tail + 1, std::memory_order_release);
+    }
+
+    T pop()
+    {
+        size_t head = headIndex.load(std::memory_order_relaxed);
+        while (tailIndex.load(std::memory_order_acquire) == head)
+        {
+            std::this_thread::yield();
+        }
+        T value = std::move(slots[head & mask]);
+        headIndex.store(head + 1, std::memory_order_release);
+        return value;
+    }
+
+  private:
+    std::vector<T> slots;
+    size_t mask;
+    alignas(64) std::atomic<size_t> headIndex{0};
+    alignas(64) std::atomic<size_t> tailIndex{0};
+};
+
+const size_t stormSizes[] = {8, 24, 64, 200, 1000};
+
+std::vector<size_t> threadCounts(size_t maxThreads, size_t step)
+{
+    std::vector<size_t> counts;
+    for (size_t threads = step; threads <= maxThreads; threads *= 2)
+    {
+        counts.push_back(threads);
+    }
+    size_t last = maxThreads - maxThreads % step;
+    if (last >= step && counts.back() != last)
+    {
+        counts.push_back(last);
+    }
+    return counts;
+}
+
+// Throughput per thread count, with efficiency against the smallest thread count
+void printScaling(BenchmarkHarness &harness, const std::string &group)
+{
+    std::cout << "\n"
+              << std::left << std::setw(44) << ("Scaling: " + group) << std::right << std::setw(10) << "Threads"
+              << std::setw(16) << "Mops/s" << std::setw(16) << "Efficiency %" << "\n";
+    std::cout << std::string(86, '-') << "\n";
+
+    const BenchmarkResult *base = nullptr;
+    for (const BenchmarkResult &result : harness.results())
+    {
+        if (result.group != group || result.threads == 0)
+        {
+            continue;
+        }
+        if (base == nullptr || base->variant != result.variant)
+        {
+            base = &result;
+        }
+        double throughput = 1000.0 / result.stats.median;
+        double baseThroughput = 1000.0 / base->stats.median;
+        double efficiency = 100.0 * throughput / (baseThroughput * double(result.threads) / double(base->threads));
+        std::cout << std::left << std::setw(44) << result.variant << std::right << std::setw(10) << result.threads
+                  << std::fixed << std::setprecision(2) << std::setw(16) << throughput << std::setw(16)
+                  << std::setprecision(1) << efficiency << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+}
+
+// Every thread creates and destroys strings of mixed sizes
+template <typename T> void constructStorm(BenchmarkHarness &harness, const char *variant, size_t threads)
+{
+    const std::string text = generateText(1024);
+    harness.runParallel("Threads Construct", variant, threads, [&](size_t thread, size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            T str(text.data(), stormSizes[(i + thread) % 5]);
+            doNotOptimize(str);
+        }
+    });
+}
+
+// Even threads produce strings, odd threads consume and free them; one operation is one push or one pop
+template <typename T> void handoff(BenchmarkHarness &harness, const char *variant, size_t threads)
+{
+    const std::string text = generateText(1024);
+    std::vector<std::unique_ptr<HandoffQueue<T>>> queues;
+    for (size_t pair = 0; pair < threads / 2; ++pair)
+    {
+        queues.push_back(std::make_unique<HandoffQueue<T>>(1024));
+    }
+    harness.runParallel("Threads Handoff", variant, threads, [&](size_t thread, size_t iterations) {
+        HandoffQueue<T> &queue = *queues[thread / 2];
+        if (thread % 2 == 0)
+        {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                queue.push(T(text.data(), stormSizes[i % 5]));
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                T str = queue.pop();
+                doNotOptimize(str);
+            }
+        }
+    });
+}
+
+// Read-only find, == and hash on strings shared by every thread
+template <typename T> void sharedReads(BenchmarkHarness &harness, const char *variant, size_t threads)
+{
+    const std::string text = generateText(4096);
+    std::vector<T> shared;
+    for (size_t i = 0; i < 1024; ++i)
+    {
+        shared.push_back(T(text.data() + i % 1024, 64 + i % 193));
+    }
+    harness.runParallel("Threads Read", variant, threads, [&](size_t thread, size_t iterations) {
+        size_t found = 0;
+        size_t hash = 0;
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const T &str = shared[(i * 7 + thread * 131) & 1023];
+            found += str.find("xyz") != std::string::npos;
+            found += str == shared[(i * 7 + thread * 131 + 1) & 1023];
+            hash ^= std::hash<T>()(str);
+        }
+        doNotOptimize(found);
+        doNotOptimize(hash);
+    });
+}
+
+// Log records of 40 to 160 bytes, formatted up front so the cases measure assembly only
+std::vector<std::string> logRecords()
+{
+    const std::string text = generateText(4096);
+    std::vector<std::string> records;
+    for (size_t i = 0; i < 64; ++i)
+    {
+        records.push_back("2024-05-01T12:00:00Z INFO " + text.substr(i * 37 % 3000, 14 + i * 29 % 120) + "\n");
+    }
+    return records;
+}
+
+// Every thread appends records to one shared output, which is handed off and emptied every 1 MB
+void mutexAppend(BenchmarkHarness &harness, const std::vector<std::string> &records, size_t threads)
+{
+    std::mutex mutex;
+    TString output;
+    harness.runParallel("Threads Append", "mutex TString::append", threads, [&](size_t thread, size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            output.append(records[(i + thread * 7) & 63]);
+            if (output.size() >= (1 << 20))
+            {
+                doNotOptimize(output);
+                output.clear();
+            }
+        }
+    });
+}
+
+// The same records through a TStringAppendBuffer of 64 KB segments, drained by the writers
+void bufferAppend(BenchmarkHarness &harness, const std::vector<std::string> &records, size_t threads)
+{
+    size_t written = 0;
+    TStringAppendBuffer buffer([&](const char *, size_t len) { written += len; }, 64 * 1024);
+    harness.runParallel("Threads Append", "TStringAppendBuffer", threads, [&](size_t thread, size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            buffer.append(records[(i + thread * 7) & 63]);
+        }
+    });
+    buffer.flush();
+    doNotOptimize(written);
+}
+
+// Runs one case for both string types at every thread count up to --threads
+template <typename Case> void scale(BenchmarkHarness &harness, const std::string &group, size_t step, Case run)
+{
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group + " (ns per op, all threads)");
+    for (size_t threads : threadCounts(harness.options().threads, step))
+    {
+        run(TString(), "TString", threads);
+    }
+    for (size_t threads : threadCounts(harness.options().threads, step))
+    {
+        run(std::string(), "std::string", threads);
+    }
+    printScaling(harness, group);
+}
+} // namespace
+
+void runThreadBenchmarks(BenchmarkHarness &harness)
+{
+    if (harness.options().threads == 0)
+    {
+        return;
+    }
+
+    scale(harness, "Threads Construct", 1, [&](auto tag, const char *variant, size_t threads) {
+        constructStorm<decltype(tag)>(harness, variant, threads);
+    });
+    if (harness.options().threads >= 2)
+    {
+        scale(harness, "Threads Handoff", 2, [&](auto tag, const char *variant, size_t threads) {
+            handoff<decltype(tag)>(harness, variant, threads);
+        });
+    }
+    scale(harness, "Threads Read", 1, [&](auto tag, const char *variant, size_t threads) {
+        sharedReads<decltype(tag)>(harness, variant, threads);
+    });
+
+    const std::string appendGroup = "Threads Append";
+    if (harness.enabled(appendGroup))
+    {
+        harness.section(appendGroup + " (ns per record, all threads)");
+        const std::vector<std::string> records = logRecords();
+        for (size_t threads : threadCounts(harness.options().threads, 1))
+        {
+            mutexAppend(harness, records, threads);
+        }
+        for (size_t threads : threadCounts(harness.options().threads, 1))
+        {
+            bufferAppend(harness, records, threads);
+        }
+        printScaling(harness, appendGroup);
+    }
+}
@@ -0,0 +1,94 @@
+#include "TString.hpp"
+#include "TStringTokenizer.hpp"
+
+#include "harness.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A comma-separated message that arrives in 4 KB chunks, tokenized either by
+// buffering the whole message into a TString and calling split, or by feeding
+// every chunk to a TStringTokenizer as it arrives.
+
+namespace
+{
+const size_t chunkSize = 4096;
+
+std::string generateMessage(size_t tokens)
+{
+    std::mt19937_64 rng(29);
+    std::string message;
+    for (size_t i = 0; i < tokens; ++i)
+    {
+        message.append(1 + rng() % 24, static_cast<char>('a' + rng() % 26));
+        message += ',';
+    }
+    return message;
+}
+
+size_t bufferAndSplit(const std::string &message)
+{
+    TString buffer;
+    for (size_t pos = 0; pos < message.size(); pos += chunkSize)
+    {
+        buffer.append(message.data() + pos, std::min(chunkSize, message.size() - pos));
+    }
+    size_t bytes = 0;
+    for (const TString &token : buffer.split(','))
+    {
+        bytes += token.size();
+    }
+    return bytes;
+}
+
+size_t stream(TStringTokenizer &tokenizer, const std::string &message)
+{
+    tokenizer.reset();
+    size_t bytes = 0;
+    for (size_t pos = 0; pos < message.size(); pos += chunkSize)
+    {
+        tokenizer.feed(std::string_view(message.data() + pos, std::min(chunkSize, message.size() - pos)));
+        for (TStringConst token : tokenizer)
+        {
+            bytes += token.size();
+        }
+    }
+    tokenizer.finish();
+    for (TStringConst token : tokenizer)
+    {
+        bytes += token.size();
+    }
+    return bytes;
+}
+} // namespace
+
+void runTokenizerBenchmarks(BenchmarkHarness &harness)
+{
+    const std::string group = "Tokenize stream";
+    if (!harness.enabled(group))
+    {
+        return;
+    }
+    harness.section(group + " (ns per token, 4 KB chunks)");
+    const size_t tokens = harness.options().elements;
+    const std::string message = generateMessage(tokens);
+
+    size_t splitBytes = 0;
+    size_t streamBytes = 0;
+    TStringTokenizer tokenizer(',');
+    harness.runBatch(
+        group, "TString buffer and split", 0, tokens, [] {}, [&] { splitBytes = bufferAndSplit(message); },
+        message.size());
+    harness.runBatch(
+        group, "TStringTokenizer", 0, tokens, [] {}, [&] { streamBytes = stream(tokenizer, message); },
+        message.size());
+    if (splitBytes != streamBytes)
+    {
+        std::cerr << "Tokenizer and split disagree: " << streamBytes << " and " << splitBytes << " token bytes"
+                  << std::endl;
+    }
+}
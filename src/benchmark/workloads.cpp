@@ -0,0 +1,356 @@
+#include "TString.hpp"
+#include "TStringMap.hpp"
+
+#include "harness.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Workloads that resemble real string processing. Every workload is written
+// once as a template and instantiated for TString and std::string, using only
+// the API both share (size, c_str, substr, +=, == and std::hash).
+// Results are reported per record and as bytes of input (or output) per second.
+
+namespace
+{
+const char *const logPaths[] = {"/index.html", "/api/v1/users", "/static/css/site.css", "/images/logo.png",
+                                "/search?q=tstring", "/api/v1/orders/checkout", "/favicon.ico", "/about"};
+const char *const logAgents[] = {"Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101 Firefox/118.0",
+                                 "Mozilla/5.0 (Windows NT 10.0; Win64; x64) AppleWebKit/537.36 Chrome/117.0",
+                                 "curl/8.4.0", "Googlebot/2.1 (+http://www.google.com/bot.html)"};
+const char *const firstNames[] = {"Alice", "Bob", "Carol", "Dave", "Erin", "Frank", "Grace", "Heidi"};
+const char *const lastNames[] = {"Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis"};
+
+// Apache combined log format
+std::vector<std::string> generateLogLines(size_t count)
+{
+    std::mt19937_64 rng(11);
+    const int statuses[] = {200, 200, 200, 200, 304, 404, 500, 301};
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string line = std::to_string(10 + rng() % 240) + "." + std::to_string(rng() % 256) + "." +
+                           std::to_string(rng() % 256) + "." + std::to_string(rng() % 256);
+        line += " - user" + std::to_string(rng() % 1000) + " [10/Oct/2023:13:" + std::to_string(10 + rng() % 50) +
+                ":" + std::to_string(10 + rng() % 50) + " -0700] \"";
+        line += rng() % 4 == 0 ? "POST " : "GET ";
+        line += logPaths[rng() % 8];
+        line += " HTTP/1.1\" " + std::to_string(statuses[rng() % 8]) + " " + std::to_string(rng() % 50000);
+        line += " \"https://www.example.com/\" \"";
+        line += logAgents[rng() % 4];
+        line += "\"";
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+// id,name,age,balance,date,active
+std::vector<std::string> generateCsvRows(size_t count)
+{
+    std::mt19937_64 rng(13);
+    std::vector<std::string> rows;
+    rows.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string row = std::to_string(i) + ",";
+        row += std::string(firstNames[rng() % 8]) + " " + lastNames[rng() % 8] + ",";
+        row += std::to_string(18 + rng() % 70) + ",";
+        row += std::to_string(rng() % 100000) + "." + std::to_string(10 + rng() % 90) + ",";
+        row += "2023-" + std::to_string(10 + rng() % 3) + "-" + std::to_string(10 + rng() % 19) + ",";
+        row += rng() % 2 ? "true" : "false";
+        rows.push_back(std::move(row));
+    }
+    return rows;
+}
+
+template <typename T> size_t findChar(const T &str, char ch, size_t pos)
+{
+    const void *found = pos < str.size() ? std::memchr(str.c_str() + pos, ch, str.size() - pos) : nullptr;
+    return found ? static_cast<const char *>(found) - str.c_str() : str.size();
+}
+
+template <typename T> size_t totalBytes(const std::vector<T> &records)
+{
+    size_t bytes = 0;
+    for (const T &record : records)
+    {
+        bytes += record.size();
+    }
+    return bytes;
+}
+
+struct LogSummary
+{
+    size_t requests = 0;
+    size_t errors = 0;
+    size_t posts = 0;
+    long long bytes = 0;
+    size_t agentLength = 0;
+
+    bool operator==(const LogSummary &) const = default;
+};
+
+// Extracts the address, method, path, status, size and user agent of every line
+template <typename T> LogSummary parseLog(const std::vector<T> &lines)
+{
+    LogSummary summary;
+    for (const T &line : lines)
+    {
+        size_t end = findChar(line, ' ', 0);
+        T address = line.substr(0, end);
+        size_t request = findChar(line, '"', end) + 1;
+        size_t methodEnd = findChar(line, ' ', request);
+        T method = line.substr(request, methodEnd - request);
+        size_t pathEnd = findChar(line, ' ', methodEnd + 1);
+        T path = line.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+        size_t statusStart = findChar(line, '"', pathEnd) + 2;
+        size_t statusEnd = findChar(line, ' ', statusStart);
+        T status = line.substr(statusStart, statusEnd - statusStart);
+        size_t sizeEnd = findChar(line, ' ', statusEnd + 1);
+        T size = line.substr(statusEnd + 1, sizeEnd - statusEnd - 1);
+        size_t agentStart = findChar(line, '"', findChar(line, '"', sizeEnd + 2) + 1) + 1;
+        T agent = line.substr(agentStart, line.size() - agentStart - 1);
+
+        summary.requests += address.size() > 0 && path.size() > 0;
+        summary.errors += std::atoi(status.c_str()) >= 500;
+        summary.posts += method == "POST";
+        summary.bytes += std::atoll(size.c_str());
+        summary.agentLength += agent.size();
+    }
+    return summary;
+}
+
+struct CsvSummary
+{
+    unsigned long long ids = 0;
+    long long ages = 0;
+    double balance = 0;
+    size_t active = 0;
+    size_t nameLength = 0;
+
+    bool operator==(const CsvSummary &) const = default;
+};
+
+// Splits every row into fields and converts the numeric and boolean ones
+template <typename T> CsvSummary parseCsv(const std::vector<T> &rows)
+{
+    CsvSummary summary;
+    std::vector<T> fields;
+    for (const T &row : rows)
+    {
+        fields.clear();
+        size_t start = 0;
+        while (start <= row.size())
+        {
+            size_t end = findChar(row, ',', start);
+            fields.push_back(row.substr(start, end - start));
+            start = end + 1;
+        }
+        summary.ids += std::strtoull(fields[0].c_str(), nullptr, 10);
+        summary.nameLength += fields[1].size();
+        summary.ages += std::atoi(fields[2].c_str());
+        summary.balance += std::strtod(fields[3].c_str(), nullptr);
+        summary.active += fields[5] == "true";
+    }
+    return summary;
+}
+
+size_t insertedId(size_t i)
+{
+    return i * 2654435761u % 1000003;
+}
+
+// Three hits for every miss
+size_t probedId(size_t i, size_t count)
+{
+    return i % 4 == 3 ? 1000003 + i : insertedId(i * 7919 % count);
+}
+
+template <typename T> T sessionKey(size_t id)
+{
+    T key("session:");
+    key += std::to_string(id).c_str();
+    key += ":user";
+    return key;
+}
+
+// Builds a map of session keys made by concatenation, then probes it with four lookups per key
+template <typename T, typename Map> size_t keyValue(Map &map, size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        map[sessionKey<T>(insertedId(i))] = i;
+    }
+    size_t found = 0;
+    for (size_t i = 0; i < 4 * count; ++i)
+    {
+        found += map.contains(sessionKey<T>(probedId(i, count)));
+    }
+    return found;
+}
+
+template <typename T> void appendNumber(T &out, long long value)
+{
+    char digits[24];
+    *std::to_chars(digits, digits + sizeof(digits) - 1, value).ptr = '\0';
+    out += digits;
+}
+
+// One JSON object per record, appended to a single output string
+template <typename T> T buildJson(size_t count)
+{
+    T out;
+    out += "[";
+    for (size_t i = 0; i < count; ++i)
+    {
+        out += i ? ",{\"id\":" : "{\"id\":";
+        appendNumber(out, static_cast<long long>(i));
+        out += ",\"name\":\"";
+        out += firstNames[i % 8];
+        out += " ";
+        out += lastNames[(i / 8) % 8];
+        out += "\",\"score\":";
+        appendNumber(out, static_cast<long long>(i * 37 % 1000));
+        out += ",\"tags\":[\"";
+        out += i % 3 ? "customer" : "admin";
+        out += "\",\"";
+        out += i % 2 ? "active" : "inactive";
+        out += "\"]}";
+    }
+    out += "]";
+    return out;
+}
+
+// Records and bytes per second, with TString's speed-up over std::string
+void printThroughput(BenchmarkHarness &harness, const std::string &group)
+{
+    std::cout << "\n"
+              << std::left << std::setw(44) << ("Throughput: " + group) << std::right << std::setw(16)
+              << "Records/s (M)" << std::setw(14) << "MB/s" << std::setw(14) << "Speed-up" << "\n";
+    std::cout << std::string(88, '-') << "\n";
+
+    double reference = 0;
+    for (const BenchmarkResult &result : harness.results())
+    {
+        if (result.group == group && result.variant == "std::string")
+        {
+            reference = result.stats.median;
+        }
+    }
+    for (const BenchmarkResult &result : harness.results())
+    {
+        if (result.group != group)
+        {
+            continue;
+        }
+        double records = 1000.0 / result.stats.median;
+        std::cout << std::left << std::setw(44) << result.variant << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(16) << records << std::setw(14) << records * result.bytesPerOperation
+                  << std::setw(13) << (reference > 0 ? reference / result.stats.median : 0) << "x" << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+}
+} // namespace
+
+void runWorkloadBenchmarks(BenchmarkHarness &harness)
+{
+    const size_t records = harness.options().elements / 10 ? harness.options().elements / 10 : 1;
+
+    if (harness.enabled("Workload Log"))
+    {
+        harness.section("Workload Log (ns per line)");
+        std::vector<std::string> raw = generateLogLines(records);
+        std::vector<TString> lines(raw.begin(), raw.end());
+        LogSummary tSummary;
+        LogSummary stdSummary;
+        harness.runBatch("Workload Log", "TString", 0, records, [] {}, [&] { tSummary = parseLog(lines); },
+                         totalBytes(raw));
+        harness.runBatch("Workload Log", "std::string", 0, records, [] {}, [&] { stdSummary = parseLog(raw); },
+                         totalBytes(raw));
+        if (tSummary != stdSummary)
+        {
+            std::cerr << "Log parsing results differ between TString and std::string" << std::endl;
+        }
+        printThroughput(harness, "Workload Log");
+    }
+
+    if (harness.enabled("Workload CSV"))
+    {
+        harness.section("Workload CSV (ns per row)");
+        std::vector<std::string> raw = generateCsvRows(records);
+        std::vector<TString> rows(raw.begin(), raw.end());
+        CsvSummary tSummary;
+        CsvSummary stdSummary;
+        harness.runBatch("Workload CSV", "TString", 0, records, [] {}, [&] { tSummary = parseCsv(rows); },
+                         totalBytes(raw));
+        harness.runBatch("Workload CSV", "std::string", 0, records, [] {}, [&] { stdSummary = parseCsv(raw); },
+                         totalBytes(raw));
+        if (tSummary != stdSummary)
+        {
+            std::cerr << "CSV parsing results differ between TString and std::string" << std::endl;
+        }
+        printThroughput(harness, "Workload CSV");
+    }
+
+    if (harness.enabled("Workload KV"))
+    {
+        // One record is one insert or one lookup; bytes are key bytes
+        harness.section("Workload KV (ns per insert or lookup)");
+        const size_t operations = 5 * records;
+        size_t keyBytes = 0;
+        for (size_t i = 0; i < records; ++i)
+        {
+            keyBytes += sessionKey<std::string>(insertedId(i)).size();
+        }
+        for (size_t i = 0; i < 4 * records; ++i)
+        {
+            keyBytes += sessionKey<std::string>(probedId(i, records)).size();
+        }
+        std::unordered_map<TString, size_t> tMap;
+        std::unordered_map<std::string, size_t> stdMap;
+        TStringMap<size_t> flatMap;
+        size_t tFound = 0;
+        size_t stdFound = 0;
+        size_t flatFound = 0;
+        harness.runBatch(
+            "Workload KV", "TString", 0, operations, [&] { tMap = {}; },
+            [&] { tFound = keyValue<TString>(tMap, records); }, keyBytes);
+        harness.runBatch(
+            "Workload KV", "std::string", 0, operations, [&] { stdMap = {}; },
+            [&] { stdFound = keyValue<std::string>(stdMap, records); }, keyBytes);
+        harness.runBatch(
+            "Workload KV", "TStringMap", 0, operations, [&] { flatMap = TStringMap<size_t>(); },
+            [&] { flatFound = keyValue<TString>(flatMap, records); }, keyBytes);
+        if (tFound != stdFound || flatFound != stdFound)
+        {
+            std::cerr << "Key-value lookups differ between implementations" << std::endl;
+        }
+        printThroughput(harness, "Workload KV");
+    }
+
+    if (harness.enabled("Workload JSON"))
+    {
+        // Bytes are output bytes
+        harness.section("Workload JSON (ns per object)");
+        size_t outputBytes = buildJson<std::string>(records).size();
+        size_t tLength = 0;
+        size_t stdLength = 0;
+        harness.runBatch("Workload JSON", "TString", 0, records, [] {},
+                         [&] { tLength = buildJson<TString>(records).size(); }, outputBytes);
+        harness.runBatch("Workload JSON", "std::string", 0, records, [] {},
+                         [&] { stdLength = buildJson<std::string>(records).size(); }, outputBytes);
+        if (tLength != stdLength)
+        {
+            std::cerr << "JSON output differs between TString and std::string" << std::endl;
+        }
+        printThroughput(harness, "Workload JSON");
+    }
+}
@@ -0,0 +1,101 @@
+#include "TString.hpp"
+
+#include <array>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Compile-time cost of the TStringConst algorithms and of building a TString on long inputs.
+//
+// Every result below is computed by the compiler. The ConstexprBench target
+// builds this file under a fixed constexpr step budget (see xmake.lua), so the
+// build fails if an algorithm stops being linear. Raise the input size with
+// -DTSTRING_CONSTEXPR_BENCH_SIZE=N, or lower the budget, to find the step cost
+// on a given compiler.
+
+#ifndef TSTRING_CONSTEXPR_BENCH_SIZE
+#define TSTRING_CONSTEXPR_BENCH_SIZE 65536
+#endif
+
+constexpr size_t haystackSize = TSTRING_CONSTEXPR_BENCH_SIZE;
+constexpr size_t needleSize = haystackSize / 64;
+
+// 'a' repeated, with 'b' at the given position: a periodic worst case for naive search
+template <size_t N> constexpr std::array<char, N + 1> repeatedWithMarker(size_t marker)
+{
+    std::array<char, N + 1> text{};
+    for (size_t i = 0; i < N; ++i)
+    {
+        text[i] = (i == marker) ? 'b' : 'a';
+    }
+    return text;
+}
+
+// "token," repeated
+template <size_t N> constexpr std::array<char, N + 1> tokenList()
+{
+    std::array<char, N + 1> text{};
+    const char pattern[] = "token,";
+    for (size_t i = 0; i < N; ++i)
+    {
+        text[i] = pattern[i % 6];
+    }
+    return text;
+}
+
+constexpr auto findHaystack = repeatedWithMarker<haystackSize>(haystackSize - 1);
+constexpr auto findNeedle = repeatedWithMarker<needleSize>(needleSize - 1);
+constexpr auto rfindHaystack = repeatedWithMarker<haystackSize>(0);
+constexpr auto rfindNeedle = repeatedWithMarker<needleSize>(0);
+constexpr auto missHaystack = repeatedWithMarker<haystackSize>(haystackSize);
+constexpr auto splitHaystack = tokenList<haystackSize>();
+
+constexpr TStringConst findText(findHaystack.data(), haystackSize);
+constexpr TStringConst rfindText(rfindHaystack.data(), haystackSize);
+constexpr TStringConst missText(missHaystack.data(), haystackSize);
+constexpr TStringConst splitText(splitHaystack.data(), haystackSize);
+
+constexpr size_t findResult = findText.find(TStringConst(findNeedle.data(), needleSize));
+constexpr size_t rfindResult = rfindText.rfind(TStringConst(rfindNeedle.data(), needleSize));
+constexpr size_t missResult = missText.find(TStringConst(findNeedle.data(), needleSize));
+constexpr bool startsResult = findText.starts_with(missText.substr(0, haystackSize - 1));
+constexpr bool endsResult = rfindText.ends_with(missText.substr(0, haystackSize - 1));
+constexpr size_t splitResult = splitText.split(',').size();
+
+// A TString built by appending one token at a time, then frozen; appends must stay amortized O(1)
+constexpr auto appendResult = tstring_freeze<[] {
+    TString text;
+    for (size_t i = 0; i < haystackSize / 6; ++i)
+    {
+        text.append("token,");
+    }
+    return text;
+}>();
+
+static_assert(findResult == haystackSize - needleSize, "Unexpected find result");
+static_assert(rfindResult == 0, "Unexpected rfind result");
+static_assert(missResult == TStringConst::npos, "Unexpected find result");
+static_assert(startsResult && endsResult, "Unexpected prefix or suffix result");
+static_assert(splitResult == (haystackSize + 5) / 6, "Unexpected split result");
+static_assert(appendResult.view() == splitText.substr(0, appendResult.size()), "Unexpected append result");
+
+void printRow(const char *operation, size_t haystack, size_t needle, const std::string &result)
+{
+    std::cout << std::left << std::setw(30) << operation << std::setw(16) << haystack << std::setw(16) << needle
+              << result << "\n";
+}
+
+int main()
+{
+    std::cout << std::left << std::setw(30) << "Operation" << std::setw(16) << "Haystack" << std::setw(16)
+              << "Needle" << "Result" << "\n";
+    std::cout << std::string(70, '-') << "\n";
+    printRow("find (periodic, last)", haystackSize, needleSize, std::to_string(findResult));
+    printRow("rfind (periodic, first)", haystackSize, needleSize, std::to_string(rfindResult));
+    printRow("find (periodic, miss)", haystackSize, needleSize, "npos");
+    printRow("starts_with", haystackSize, haystackSize - 1, startsResult ? "true" : "false");
+    printRow("ends_with", haystackSize, haystackSize - 1, endsResult ? "true" : "false");
+    printRow("split", haystackSize, 1, std::to_string(splitResult));
+    printRow("TString append + freeze", appendResult.size(), 6, std::to_string(appendResult.size()));
+    return 0;
+}
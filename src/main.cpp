@@ -1,6 +1,24 @@
 #include "TString.hpp"
+#include "TStringAppendBuffer.hpp"
+#include "TStringArchive.hpp"
+#include "TStringCompact.hpp"
+#include "TStringFuzzy.hpp"
+#include "TStringInterop.hpp"
+#include "TStringMap.hpp"
+#include "TStringPattern.hpp"
+#include "TStringSort.hpp"
+#include "TStringSwitch.hpp"
+#include "TStringTokenizer.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
 
 void run_tests()
 {
@@ -55,6 +73,377 @@ void run_tests()
     static_assert(isEqual, "Unexpected comparison result");
     constexpr bool isNotEqual = (constStr != TStringConst("Another String"));
     static_assert(isNotEqual, "Unexpected comparison result");
+
+    static_assert(constStr.find("Time") == 8, "Unexpected find result");
+    static_assert(constStr.find("Times") == TStringConst::npos, "Unexpected find result");
+    static_assert(TStringConst("abcabcabd").find("abcabd") == 3, "Unexpected find result");
+    static_assert(TStringConst("abcabcabc").rfind("abc") == 6, "Unexpected rfind result");
+    static_assert(TStringConst("abcabcabc").rfind("abc", 5) == 3, "Unexpected rfind result");
+    static_assert(constStr.starts_with("Compile") && constStr.ends_with("String"), "Unexpected affix result");
+    static_assert(constStr.substr(8, 4) == "Time", "Unexpected substr result");
+    static_assert(constStr.substr(13) == TStringConst("String"), "Unexpected substr result");
+    static_assert(TStringConst("a,b,,c").split(',').size() == 3, "Unexpected split result");
+    static_assert(TStringConst("a,b,,c").split(',')[2] == "c", "Unexpected split result");
+    std::cout << "TStringConst find 'Time': " << constStr.find("Time") << ", rfind 'i': " << constStr.rfind('i')
+              << std::endl;
+
+    // constexpr TString tests
+    static_assert((TString("Hello, ") + "World").size() == 12, "Unexpected constexpr concatenation");
+    static_assert(TString("key:") + TString("42") == "key:42", "Unexpected constexpr concatenation");
+    static_assert(TString("abcdef").substr(2, 3) == "cde", "Unexpected constexpr substr");
+    static_assert(TString("apple") < TString("apples"), "Unexpected constexpr comparison");
+    static constexpr auto frozenKey = tstring_freeze<[] {
+        TString key("user:");
+        key.append("42");
+        key += ':';
+        key.append(3, '-');
+        return key + "profile";
+    }>();
+    static_assert(frozenKey.view() == "user:42:---profile", "Unexpected frozen string");
+    std::cout << "Frozen key: " << frozenKey.c_str() << std::endl;
+
+    // TStringSort tests
+    std::vector<TString> keys = {"banana", "apple pie", "", "cherry", "app", "apple", "banana"};
+    std::vector<TString> expectedKeys = keys;
+    std::sort(expectedKeys.begin(), expectedKeys.end());
+    tstring_sort(keys);
+    std::cout << "tstring_sort matches std::sort: " << (keys == expectedKeys) << std::endl;
+
+    // Enough keys for the radix pass and the parallel buckets, with four threads even on one core. Most share a
+    // long prefix, so whole buckets reach multikey quicksort; the rest are short or empty.
+    std::vector<TString> manyKeys;
+    uint32_t seed = 26;
+    for (size_t i = 0; i < 70000; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t value = seed >> 8;
+        switch (value % 8)
+        {
+        case 0:
+            manyKeys.push_back(TString(""));
+            break;
+        case 1:
+            manyKeys.push_back(TString(std::string(1 + value % 3, static_cast<char>('a' + value % 5)).c_str()));
+            break;
+        default:
+            manyKeys.push_back(TString(("shared/prefix/for/every/key/" + std::to_string(value % 4) + "/" +
+                                        std::to_string(value % 100000))
+                                           .c_str()));
+            break;
+        }
+    }
+    std::vector<TString> expectedManyKeys = manyKeys;
+    std::sort(expectedManyKeys.begin(), expectedManyKeys.end());
+    TStringColumn manyColumn;
+    for (const TString &key : manyKeys)
+    {
+        manyColumn.push_back(key.c_str(), key.size());
+    }
+    tstring_sort(manyKeys, 4);
+    tstring_sort(manyColumn, 4);
+    bool columnSorted = manyColumn.size() == expectedManyKeys.size();
+    for (size_t i = 0; columnSorted && i < manyColumn.size(); ++i)
+    {
+        columnSorted = std::string_view(manyColumn[i].c_str(), manyColumn[i].size()) ==
+                       std::string_view(expectedManyKeys[i]);
+    }
+    std::cout << "tstring_sort of " << manyKeys.size() << " keys matches std::sort: "
+              << (manyKeys == expectedManyKeys) << " " << columnSorted << std::endl;
+
+    TStringColumn column;
+    column.push_back("delta");
+    column.push_back("alpha");
+    column.push_back("charlie");
+    tstring_sort(column);
+    std::cout << "Sorted column: " << column[0].c_str() << " " << column[1].c_str() << " " << column[2].c_str()
+              << std::endl;
+
+    // TStringCompact tests
+    TString longKey("customer_id_000042");
+    TString otherLongKey("customer_id_000043");
+    TStringCompact compactShort("user_id");
+    TStringCompact compactLong(longKey);
+    TStringCompact compactOther(otherLongKey);
+    std::cout << "TStringCompact inline: " << compactShort.is_inline() << " " << compactLong.is_inline() << std::endl;
+    std::cout << "TStringCompact equal: " << (compactLong == TStringCompact("customer_id_000042"))
+              << ", less: " << (compactLong < compactOther) << ", greater: " << (compactShort > compactLong)
+              << std::endl;
+    std::cout << "TStringCompact view: " << compactLong.view() << std::endl;
+
+    // TStringMap tests
+    TStringMap<int> wordCounts;
+    for (const auto &part : TString("to be or not to be").split(' '))
+    {
+        ++wordCounts[part];
+    }
+    std::cout << "TStringMap size: " << wordCounts.size() << ", count of 'be': " << *wordCounts.find("be")
+              << ", contains 'maybe': " << wordCounts.contains(std::string_view("maybe")) << std::endl;
+    wordCounts.erase(TStringConst("or"));
+    std::cout << "TStringMap size after erase: " << wordCounts.size() << std::endl;
+
+    // TStringSwitch tests
+    static constexpr TStringSwitch commands({"get", "set", "delete", "list", "quit"});
+    static_assert(commands.lookup("delete") == 2, "Unexpected lookup result");
+    static_assert(commands.lookup("deletes") == commands.npos, "Unexpected lookup result");
+    static_assert(tstring_hash_fnv("get"_TC) == 0x540ca757u, "Unexpected FNV-1a hash");
+    std::cout << "TStringSwitch lookup 'quit': " << commands.lookup(TString("quit"))
+              << ", 'stop' found: " << (commands.lookup(TString("stop")) != commands.npos) << std::endl;
+    constexpr uint64_t literalHash = tstring_hash("get"_TC);
+    std::cout << "Compile-time hash matches runtime: " << (literalHash == tstring_hash(TString("get"))) << std::endl;
+    std::vector<TString> hashKeys;
+    for (size_t len = 0; len < 70; ++len)
+    {
+        hashKeys.push_back(TString(std::string(len, static_cast<char>('a' + len % 26)).c_str()));
+    }
+    std::vector<uint64_t> batchHashes(hashKeys.size());
+    std::vector<uint32_t> batchFnv(hashKeys.size());
+    tstring_hash_batch(hashKeys, batchHashes, 7);
+    tstring_hash_fnv_batch(hashKeys, batchFnv);
+    bool batchMatches = true;
+    for (size_t i = 0; i < hashKeys.size(); ++i)
+    {
+        batchMatches = batchMatches && batchHashes[i] == tstring_hash(hashKeys[i], 7) &&
+                       batchFnv[i] == tstring_hash_fnv(hashKeys[i]);
+    }
+    std::cout << "Batch hashes match: " << batchMatches << std::endl;
+#ifdef TCSTRING_SUPPORT
+    // The batch FNV-1a must agree with the TCString hash that TString::hash_fnv() returns
+    bool tcstringFnvMatches = true;
+    for (size_t i = 0; i < hashKeys.size(); ++i)
+    {
+        tcstringFnvMatches = tcstringFnvMatches && batchFnv[i] == hashKeys[i].hash_fnv();
+    }
+    std::cout << "Batch FNV matches TString::hash_fnv: " << tcstringFnvMatches << std::endl;
+#endif
+
+    // Append fast path tests
+    TString built;
+    built.push_back('[');
+    built.append("key=value", 3);
+    built.append(std::string_view("=42"));
+    built.append(2, ']');
+    built += '!';
+    built.append(built.c_str(), 4);
+    std::cout << "Built string: " << built << std::endl;
+    built.resize(3);
+    built.resize_and_overwrite(16, [](char *data, size_t count) {
+        std::memcpy(data + 3, "-resized", 8);
+        return count < 11 ? count : 11;
+    });
+    TString chained = TString("a") + "b" + std::string("c") + built;
+    std::cout << "Resized: " << built << ", chained: " << chained << std::endl;
+
+    // A moved-from string has no buffer and must still take appends
+    TString movedTo(std::move(chained));
+    chained.push_back('x');
+    chained.append(2, 'y');
+    chained.append("z", 1);
+    TString movedAgain(std::move(movedTo));
+    movedTo.reserve(32);
+    movedTo.append("reused");
+    std::cout << "Moved-from appends: " << chained << " " << movedTo << std::endl;
+
+    // Growth policy tests
+    static_assert(TStringGrowthPowerOfTwo::initial(514) == 1024, "Unexpected power of two capacity");
+    static_assert(TStringGrowthGeometric::initial(514) == 514, "Unexpected geometric capacity");
+    static_assert(TStringGrowthGeometric::grow(600, 601) == 900, "Unexpected geometric growth");
+    TStringBasic<TStringGrowthGeometric> geometric("x");
+    geometric.reserve(600);
+    geometric.append(513, 'y');
+    std::cout << "Reserved buffer kept: " << geometric.buffer_size() << ", size: " << geometric.size();
+    geometric.clear();
+    std::cout << ", after clear: " << geometric.buffer_size();
+    geometric.shrink_to_fit();
+    std::cout << ", after shrink_to_fit: " << geometric.buffer_size() << std::endl;
+    TStringBasic<TStringGrowthExactFit> exact(std::string(513, 'z'));
+    std::cout << "Exact fit buffer for 514 bytes is smaller than 1024: "
+              << (exact.buffer_size() >= 514 && exact.buffer_size() < 1024) << std::endl;
+
+    // TStringArchive tests
+    std::string archivePath = (std::filesystem::temp_directory_path() / "tstring_main_test.tsa").string();
+    std::vector<TString> dictionary = {"alpha", "", "gamma ray", std::string("nul\0inside", 10)};
+    tstring_save(archivePath, dictionary);
+    {
+        TStringArchive archive(archivePath);
+        std::cout << "Archive size: " << archive.size() << ", element 2: " << archive[2].c_str()
+                  << ", element 3 length: " << archive[3].size() << std::endl;
+    }
+    // Compared byte for byte, so the bytes after the NUL in element 3 are checked too
+    std::vector<TString> loaded = tstring_load(archivePath);
+    bool roundTrip = loaded.size() == dictionary.size();
+    for (size_t i = 0; roundTrip && i < loaded.size(); ++i)
+    {
+        roundTrip = loaded[i].size() == dictionary[i].size() &&
+                    std::memcmp(loaded[i].c_str(), dictionary[i].c_str(), loaded[i].size()) == 0;
+    }
+    std::cout << "Archive round trip: " << roundTrip << std::endl;
+    {
+        std::fstream corrupt(archivePath, std::ios::in | std::ios::out | std::ios::binary);
+        corrupt.seekp(-3, std::ios::end);
+        corrupt.put('X');
+    }
+    try
+    {
+        tstring_load(archivePath);
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cout << "Corrupt archive rejected: " << (std::string(error.what()).find("checksum") != std::string::npos)
+                  << std::endl;
+    }
+    std::filesystem::remove(archivePath);
+    try
+    {
+        TStringArchive missing(archivePath);
+    }
+    catch (const std::runtime_error &error)
+    {
+        std::cout << "Missing archive rejected: " << (std::string(error.what()).find("open") != std::string::npos)
+                  << std::endl;
+    }
+
+    // TStringTokenizer tests
+    TStringTokenizer tokenizer(TStringConst(", "));
+    std::cout << "Streamed tokens:";
+    for (const char *chunk : {"alpha,be", "ta,,gam", "ma del", "ta"})
+    {
+        tokenizer.feed(chunk);
+        for (TStringConst token : tokenizer)
+        {
+            std::cout << " [" << std::string_view(token.c_str(), token.size()) << "]";
+        }
+    }
+    tokenizer.finish();
+    for (TStringConst token : tokenizer)
+    {
+        std::cout << " [" << std::string_view(token.c_str(), token.size()) << "]";
+    }
+    std::cout << ", done: " << tokenizer.done() << std::endl;
+
+    // TStringAppendBuffer tests
+    TString appended;
+    {
+        // Small segments, so the writers rotate through the ring many times
+        TStringAppendBuffer log([&](const char *str, size_t len) { appended.append(str, len); }, 64, 2);
+        std::vector<std::thread> writers;
+        for (int writer = 0; writer < 4; ++writer)
+        {
+            writers.emplace_back([&log, writer] {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    log.append(TString(std::to_string(writer * 1000 + i).c_str()) + "\n");
+                }
+            });
+        }
+        for (std::thread &thread : writers)
+        {
+            thread.join();
+        }
+    }
+    std::vector<bool> seen(4000);
+    size_t records = 0;
+    for (const TString &record : appended.split('\n'))
+    {
+        size_t value = std::stoul(std::string(record.c_str(), record.size()));
+        records += value < seen.size() && !seen[value];
+        seen[std::min(value, seen.size() - 1)] = true;
+    }
+    std::cout << "Concurrent appends intact: " << records << " of 4000" << std::endl;
+
+    // TStringPattern tests
+    TStringPattern latency("svc.*.latency_p9?");
+    std::cout << "Pattern match: " << latency.match("svc.billing.latency_p99") << latency.match("svc.latency_p99")
+              << TStringPattern("[!a-c]x[\\]]*").match(TStringConst("dx]tail")) << std::endl;
+    TStringColumn metricKeys;
+    for (const char *key : {"svc.api.latency_p95", "svc.api.errors", "host.db.latency_p99", "svc.db.latency_p90"})
+    {
+        metricKeys.push_back(key);
+    }
+    std::cout << "Filtered:";
+    for (size_t index : latency.filter(metricKeys))
+    {
+        std::cout << " " << metricKeys[index].c_str();
+    }
+    std::cout << std::endl;
+    // A middle segment of 100 positions with classes spans two Shift-And words
+    std::string longSegment;
+    for (size_t i = 0; i < 50; ++i)
+    {
+        longSegment += "?[0-9]";
+    }
+    TStringPattern longPattern(("id*" + longSegment + "*end").c_str());
+    std::string longText = "id-" + std::string(100, '7') + "-end";
+    std::string shortText = "id-" + std::string(98, '7') + "-end";
+    std::cout << "Long segment match: " << longPattern.match(TStringConst(longText.c_str(), longText.size()))
+              << longPattern.match(TStringConst(shortText.c_str(), shortText.size())) << std::endl;
+
+    // TStringFuzzy tests
+    std::cout << "Edit distance: " << tstring_edit_distance(TStringConst("kitten"), TStringConst("sitting"))
+              << ", bounded: " << tstring_edit_distance(TStringConst("kitten"), TStringConst("sitting"), 1)
+              << ", long: " << tstring_edit_distance(TString(std::string(100, 'a').c_str()), TString("b")) << std::endl;
+    TStringFuzzyMatch typo = TStringFuzzy("keyboard", 2).find(TStringConst("wireless keybaord and mouse"));
+    std::cout << "Fuzzy find: " << typo.pos << " " << typo.length << " " << typo.distance << std::endl;
+    std::vector<TString> products = {TString("mouse"), TString("moose"), TString("house pad"), TString("mice")};
+    std::cout << "Fuzzy hits:";
+    for (TStringFuzzyHit hit : TStringFuzzy("mouse", 1).filter(products))
+    {
+        std::cout << " " << products[hit.index].c_str() << "/" << hit.distance;
+    }
+    std::cout << std::endl;
+
+    // TStringInterop tests
+    const TString viewed("interop");
+    std::string_view viewedAs = viewed;
+    const TString fromView(std::string_view("from view"));
+    char *block = static_cast<char *>(std::malloc(16));
+    std::memcpy(block, "adopted", 7);
+    TString adopted = TString::adopt(block, 7, 16);
+    std::cout << "Interop: " << viewedAs.size() << " " << fromView.c_str() << " " << adopted.c_str() << std::endl;
+    std::free(adopted.release());
+    adopted.append("released, then reused");
+    std::cout << "After release: " << adopted << std::endl;
+    const TString withNul(std::string("a\0b", 3));
+    std::cout << "Embedded NUL comparisons: " << (withNul == TString("a")) << " " << (withNul > TString("a")) << " "
+              << (withNul < TString(std::string("a\0c", 3))) << " "
+              << (withNul == std::string(std::string_view(withNul))) << std::endl;
+    const std::vector<std::string> stdStrings = {"alpha", "", std::string("nul\0byte", 8)};
+    const std::vector<TString> converted = tstring_from_strings(stdStrings);
+    std::cout << "Bulk conversions round-trip: " << (tstring_to_strings(converted) == stdStrings) << " "
+              << (tstring_to_strings(tstring_column_from_strings(stdStrings)) == stdStrings) << " "
+              << (converted[2] == stdStrings[2]) << " " << (tstring_views(converted)[2].size() == 8) << std::endl;
+
+#ifdef TSTRING_INSTRUMENT
+    // Allocation instrumentation tests
+    TStringAllocationStats before = tstring_thread_stats();
+    {
+        TString grown("abc");
+        grown.append("defgh");
+        grown.reserve(64);
+    }
+    TStringAllocationStats cost = tstring_thread_stats() - before;
+    std::cout << "Allocations: " << cost.allocations << ", frees: " << cost.frees << ", growths: " << cost.growths
+              << ", bytes copied: " << cost.bytesCopied << ", 64-byte buffers: " << cost.sizeClasses[6] << std::endl;
+    std::cout << "Global allocations include this thread: "
+              << (tstring_global_stats().allocations >= tstring_thread_stats().allocations) << std::endl;
+
+    TString shrunk("abc");
+    shrunk.reserve(256);
+    before = tstring_thread_stats();
+    shrunk.shrink_to_fit();
+    cost = tstring_thread_stats() - before;
+    std::cout << "shrink_to_fit reallocations: " << cost.allocations << ", growths: " << cost.growths << std::endl;
+
+    before = tstring_thread_stats();
+    {
+        char *block = static_cast<char *>(std::malloc(16));
+        std::memcpy(block, "adopted", 7);
+        TString adopted = TString::adopt(block, 7, 16);
+        TString released("released");
+        std::free(released.release());
+    }
+    cost = tstring_thread_stats() - before;
+    std::cout << "Adopt and release allocations: " << cost.allocations << ", frees: " << cost.frees << std::endl;
+#endif
 }
 
 int main()
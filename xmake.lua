@@ -14,6 +14,20 @@ option("stl")
     add_defines("STL_SUPPORT")
 option_end()
 
+option("instrument")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Count TString allocations and copies (TStringInstrument.hpp)")
+    add_defines("TSTRING_INSTRUMENT")
+option_end()
+
+option("growth")
+    set_default("pow2")
+    set_showmenu(true)
+    set_values("pow2", "geometric", "exact")
+    set_description("TString growth policy: pow2, geometric (1.5x) or exact (fit plus allocator slack)")
+option_end()
+
 if has_config("tcstring") then
     add_requires("tcstring >0.1.3")
 end
@@ -21,9 +35,14 @@ end
 target("tstring")
     set_kind("headeronly")
     set_encodings("utf-8")
-    set_options("tcstring", "stl", {public = true})
+    set_options("tcstring", "stl", "instrument", {public = true})
 
-    add_headerfiles("include/TString.hpp")
+    add_headerfiles("include/*.hpp")
+
+    local growthPolicies = {geometric = "TStringGrowthGeometric", exact = "TStringGrowthExactFit"}
+    if growthPolicies[get_config("growth")] then
+        add_defines("TSTRING_GROWTH_POLICY=" .. growthPolicies[get_config("growth")], {public = true})
+    end
 
     if has_config("tcstring") then
         add_packages("tcstring", {public = true})
@@ -44,8 +63,21 @@ target("BenchMark")
     set_kind("binary")
     set_encodings("utf-8")
 
-    add_files("src/benchmark.cpp")
+    add_files("src/benchmark/*.cpp")
+    add_includedirs("include")
+
+    add_deps("tstring")
+target_end()
+
+target("ConstexprBench")
+    set_kind("binary")
+    set_encodings("utf-8")
+
+    add_files("src/constexpr_benchmark.cpp")
     add_includedirs("include")
+    -- Every constant expression in this target has to fit in this step budget
+    add_cxxflags("gcc::-fconstexpr-ops-limit=16777216", "clang::-fconstexpr-steps=16777216",
+                 "cl::/constexpr:steps16777216")
 
     add_deps("tstring")
 target_end()